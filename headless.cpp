@@ -0,0 +1,194 @@
+/**
+* Headless driver: runs the exploration and combat scenes with no window,
+* GPU or audio device, against the null backend (lib/NullBackend.cpp).
+* Build with `make headless`.
+*
+*   ./game_headless --encounters 1000 [--level 0] [--seed 1] [--input "..."]
+*       Fights back-to-back battles in CombatScene and reports the outcomes.
+*   ./game_headless --scene 0 [--ticks 3600] [--input "..."]
+*       Runs one exploration scene until it asks to switch scenes.
+*
+* --input takes a NullBackend input script, e.g. "30 RIGHT; 1 SPACE; 1 -".
+* --profile prints the profiler's per-tick zone timings at the end.
+**/
+
+#include "lib/cs3113.h"
+#include "lib/GameTypes.h"
+#include "lib/GameData.h"
+#include "lib/CombatRules.h"
+#include "lib/NullBackend.h"
+#include "lib/Input.h"
+#include "lib/Profiler.h"
+#include "scenes/LevelOne.h"
+#include "scenes/LevelTwo.h"
+#include "scenes/LevelThree.h"
+#include "scenes/CombatScene.h"
+#include <chrono>
+
+constexpr float FIXED_TIMESTEP = 1.0f / 60.0f; // same tick as main.cpp
+constexpr int   MAX_BATTLE_TICKS = 60 * 60 * 10; // ten simulated minutes
+
+// Globals the scenes share with main.cpp
+int gCurrentLevelIndex = -1;
+float gMusicVolume = 0.0f;
+float gSFXVolume   = 0.0f;
+Texture2D gPartyIcons[4];
+
+// Confirms every menu (SPACE/ENTER) on alternate ticks: always picks the
+// highlighted action and target, and dismisses victory/defeat screens
+static const char *DEFAULT_COMBAT_INPUT = "1 SPACE ENTER; 1 -";
+
+static int runEncounters(int encounters, int level, uint64_t seed)
+{
+    CombatScene combat({ 500.0f, 300.0f }, "#000000");
+    gCurrentLevelIndex = 2;
+    combat.getState().rng.seed(seed, 2); // salted like main.cpp's combat scene
+
+    int wins = 0, losses = 0, timeouts = 0;
+    long long totalTicks = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int n = 0; n < encounters; n++)
+    {
+        GameState &state = combat.getState();
+        state.party             = makeStartingParty(level);
+        state.inventory         = INITIAL_INVENTORY();
+        state.returnSceneID     = level;
+        state.engagedEnemyIndex = -1;
+        state.combatAdvantage   = true;
+        combat.initialise();
+
+        int ticks = 0;
+        while (state.nextSceneID == -1 && ticks < MAX_BATTLE_TICKS)
+        {
+            gProfiler.beginFrame();
+            headlessStep(FIXED_TIMESTEP);
+            gInput.poll();
+            gInput.beginTick();
+            {
+                PROFILE_SCOPE(PROFILE_SCENE_UPDATE);
+                combat.update(FIXED_TIMESTEP);
+            }
+            gProfiler.endFrame();
+            ticks++;
+        }
+        totalTicks += ticks;
+
+        if (state.nextSceneID == -1) timeouts++;
+        else if (!state.party.empty() && state.party[0].isAlive) wins++;
+        else losses++;
+
+        state.nextSceneID = -1;
+        combat.shutdown();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("encounters %d  wins %d  losses %d  timeouts %d\n", encounters, wins, losses, timeouts);
+    printf("avg battle %.1f s simulated  |  %.3f s wall, %.0f encounters/s\n",
+        encounters > 0 ? totalTicks * FIXED_TIMESTEP / encounters : 0.0f,
+        seconds, seconds > 0.0 ? encounters / seconds : 0.0);
+    return timeouts == 0 ? 0 : 1;
+}
+
+static int runScene(int sceneIndex, int maxTicks, uint64_t seed)
+{
+    // Scenes have no virtual destructor, so they live here rather than on the heap
+    LevelOne   levelOne({ 500.0f, 300.0f }, "#000000");
+    LevelTwo   levelTwo({ 500.0f, 300.0f }, "#000000");
+    LevelThree levelThree({ 500.0f, 300.0f }, "#000000");
+
+    Scene *scene = nullptr;
+    switch (sceneIndex)
+    {
+        case 0: scene = &levelOne;   break;
+        case 1: scene = &levelTwo;   break;
+        case 4: scene = &levelThree; break;
+        default:
+            printf("headless: no exploration scene %d (use 0, 1 or 4)\n", sceneIndex);
+            return 1;
+    }
+
+    gCurrentLevelIndex = sceneIndex;
+    GameState &state = scene->getState();
+    state.rng.seed(seed, (uint64_t) sceneIndex);
+    state.inventory = INITIAL_INVENTORY();
+    scene->initialise();
+
+    int ticks = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (state.nextSceneID == -1 && ticks < maxTicks)
+    {
+        gProfiler.beginFrame();
+        headlessStep(FIXED_TIMESTEP);
+        gInput.poll();
+        gInput.beginTick();
+
+        // Exploration movement, as in main.cpp's processInput()
+        if (state.player) {
+            state.player->resetMovement();
+            if (gInput.isDown(KEY_A)) state.player->moveLeft();
+            if (gInput.isDown(KEY_D)) state.player->moveRight();
+            if (gInput.isDown(KEY_W)) state.player->moveUp();
+            if (gInput.isDown(KEY_S)) state.player->moveDown();
+            if (GetLength(state.player->getMovement()) > 1.0f) state.player->normaliseMovement();
+        }
+
+        {
+            PROFILE_SCOPE(PROFILE_SCENE_UPDATE);
+            scene->update(FIXED_TIMESTEP);
+        }
+        // Map and sprite work goes through the null backend, so this times
+        // culling and batching only
+        scene->render();
+        gProfiler.endFrame();
+        ticks++;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Vector2 position = state.player ? state.player->getPosition() : Vector2{ 0.0f, 0.0f };
+    printf("scene %d  ticks %d (%.1f s simulated, %.3f s wall)\n", sceneIndex, ticks, ticks * FIXED_TIMESTEP, seconds);
+    printf("player at (%.1f, %.1f)  next scene %d  engaged enemy %d\n",
+        position.x, position.y, state.nextSceneID, state.engagedEnemyIndex);
+
+    scene->shutdown();
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int encounters = 0;
+    int level      = 0;
+    int sceneIndex = -1;
+    int maxTicks   = 60 * 60;
+    uint64_t seed  = 1;
+    const char *input = nullptr;
+    bool profile   = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if      (arg == "--encounters" && hasValue) encounters = atoi(argv[++i]);
+        else if (arg == "--level"      && hasValue) level      = atoi(argv[++i]);
+        else if (arg == "--scene"      && hasValue) sceneIndex = atoi(argv[++i]);
+        else if (arg == "--ticks"      && hasValue) maxTicks   = atoi(argv[++i]);
+        else if (arg == "--seed"       && hasValue) seed       = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--input"      && hasValue) input      = argv[++i];
+        else if (arg == "--profile")                profile    = true;
+        else {
+            printf("usage: %s (--encounters N [--level L] | --scene S [--ticks T]) [--seed N] [--input SCRIPT] [--profile]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Timing only costs anything when asked for
+    gProfiler.setEnabled(profile);
+    if (!gContentDB.load(CONTENT_BLOB_PATH)) return 1;
+
+    if (!headlessLoadInput(input ? input : (sceneIndex >= 0 ? "" : DEFAULT_COMBAT_INPUT))) return 1;
+
+    int result = sceneIndex >= 0 ? runScene(sceneIndex, maxTicks, seed) : runEncounters(encounters, level, seed);
+    if (profile) gProfiler.printReport();
+    gAssetCache.unloadAll();
+    return result;
+}
@@ -0,0 +1,75 @@
+#include "AIScheduler.h"
+#include <chrono>
+
+constexpr float AIScheduler::NEAR_INTERVAL;
+constexpr float AIScheduler::IDLE_INTERVAL;
+constexpr float AIScheduler::FAR_INTERVAL;
+constexpr float AIScheduler::NEAR_DISTANCE;
+constexpr float AIScheduler::FAR_DISTANCE;
+
+bool AIScheduler::sDeterministic = false;
+
+// Only these AI types have a perception query to schedule
+static bool hasSenses(Entity *enemy)
+{
+    return enemy->getAIType() == AI_GUARD || enemy->getAIType() == AI_SEARCHLIGHT;
+}
+
+void AIScheduler::reset(int enemyCount)
+{
+    mCursor = 0;
+    mTimeSinceSensed.assign(enemyCount, FAR_INTERVAL);
+}
+
+float AIScheduler::getSenseInterval(Entity *enemy, Entity *player) const
+{
+    if (enemy->getAIState() == RETURNING) return NEAR_INTERVAL;
+
+    float distance = Vector2Distance(enemy->getPosition(), player->getPosition());
+    if (distance < NEAR_DISTANCE) return NEAR_INTERVAL;
+    if (distance < FAR_DISTANCE)  return IDLE_INTERVAL;
+
+    return FAR_INTERVAL;
+}
+
+void AIScheduler::update(Entity *enemies, int enemyCount, Entity *player, Map *map, float deltaTime)
+{
+    if (enemies == nullptr || player == nullptr || enemyCount <= 0) return;
+    if ((int) mTimeSinceSensed.size() != enemyCount) reset(enemyCount);
+
+    for (float &age : mTimeSinceSensed) age += deltaTime;
+
+    // Pursuers are never deferred, so a chase ends as soon as sight is lost
+    for (int i = 0; i < enemyCount; i++)
+    {
+        Entity *enemy = &enemies[i];
+        if (!enemy->isActive() || !hasSenses(enemy) || enemy->getAIState() != CHASING) continue;
+
+        enemy->setPerception(enemy->sensePlayer(player, map));
+        mTimeSinceSensed[i] = 0.0f;
+    }
+
+    // Everyone else shares the budget; resuming where the last tick stopped
+    // means nobody starves when the budget runs out
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < enemyCount; n++)
+    {
+        int i = (mCursor + n) % enemyCount;
+        Entity *enemy = &enemies[i];
+        if (!enemy->isActive() || !hasSenses(enemy) || enemy->getAIState() == CHASING) continue;
+        if (mTimeSinceSensed[i] < getSenseInterval(enemy, player)) continue;
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        if (!sDeterministic && elapsed >= mBudgetMicroseconds)
+        {
+            mCursor = i;
+            return;
+        }
+
+        enemy->setPerception(enemy->sensePlayer(player, map));
+        mTimeSinceSensed[i] = 0.0f;
+    }
+
+    mCursor = (mCursor + 1) % enemyCount;
+}
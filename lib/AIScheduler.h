@@ -0,0 +1,47 @@
+#include "Entity.h"
+
+#ifndef AI_SCHEDULER_H
+#define AI_SCHEDULER_H
+
+// Decides which enemies re-run their perception query (Entity::sensePlayer)
+// each tick and caches the answer on the entity, so the AI and the scene's
+// detection pass share one query. Pursuers sense every tick; everyone else
+// is refreshed at a rate set by their state and distance to the player,
+// round-robin, until the tick's time budget is spent.
+class AIScheduler
+{
+private:
+    int   mBudgetMicroseconds;
+    int   mCursor = 0;               // where the next round-robin pass starts
+    std::vector<float> mTimeSinceSensed; // per enemy index
+
+    static bool sDeterministic;
+
+    float getSenseInterval(Entity *enemy, Entity *player) const;
+
+public:
+    // Seconds between perception updates for each tier
+    static constexpr float NEAR_INTERVAL = 0.1f;  // returning, or near the player
+    static constexpr float IDLE_INTERVAL = 0.25f; // idle/patrolling at mid range
+    static constexpr float FAR_INTERVAL  = 0.5f;  // far from the player
+
+    static constexpr float NEAR_DISTANCE = 250.0f;
+    static constexpr float FAR_DISTANCE  = 500.0f;
+
+    explicit AIScheduler(int budgetMicroseconds = 500) : mBudgetMicroseconds {budgetMicroseconds} { }
+
+    void setBudget(int microseconds) { mBudgetMicroseconds = microseconds; }
+
+    // Ignore the time budget in every scheduler (every due enemy is sensed),
+    // so results depend only on input and seed, e.g. while replaying input
+    static void setDeterministic(bool deterministic) { sDeterministic = deterministic; }
+    int  getBudget() const           { return mBudgetMicroseconds;         }
+
+    // Forgets timings; every enemy is sensed on the next update
+    void reset(int enemyCount);
+
+    // Call once per tick before the enemies update
+    void update(Entity *enemies, int enemyCount, Entity *player, Map *map, float deltaTime);
+};
+
+#endif // AI_SCHEDULER_H
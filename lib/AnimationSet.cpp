@@ -0,0 +1,51 @@
+#include "AnimationSet.h"
+#include <tuple>
+
+constexpr int AnimationSet::DIRECTION_COUNT;
+
+AnimationSet::AnimationSet(const std::map<Direction, std::vector<int>> &atlas)
+{
+    // Resolve every direction to the frames it plays (same fallback order
+    // the per-frame lookup used to apply)
+    const std::vector<int> *sources[DIRECTION_COUNT] = {};
+    auto fallback = atlas.find(RIGHT);
+    if (fallback == atlas.end()) fallback = atlas.begin();
+
+    int totalFrames = 0;
+    for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+    {
+        auto it = atlas.find((Direction) direction);
+        if (it == atlas.end()) it = fallback;
+        if (it == atlas.end()) continue; // empty atlas
+
+        sources[direction] = &it->second;
+        totalFrames += (int) it->second.size();
+    }
+
+    // Reserve up front so the clip pointers stay valid
+    mFrames.reserve(totalFrames);
+    for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+    {
+        mClips[direction] = { nullptr, 0 };
+        if (sources[direction] == nullptr || sources[direction]->empty()) continue;
+
+        mClips[direction].frames     = mFrames.data() + mFrames.size();
+        mClips[direction].frameCount = (int) sources[direction]->size();
+        mFrames.insert(mFrames.end(), sources[direction]->begin(), sources[direction]->end());
+    }
+}
+
+const AnimationSet *internAnimationSet(const std::map<Direction, std::vector<int>> &atlas)
+{
+    // std::map nodes never move, so handing out pointers to them is safe
+    static std::map<std::map<Direction, std::vector<int>>, AnimationSet> sets;
+
+    auto it = sets.find(atlas);
+    if (it == sets.end())
+    {
+        it = sets.emplace(std::piecewise_construct,
+            std::forward_as_tuple(atlas), std::forward_as_tuple(atlas)).first;
+    }
+
+    return &it->second;
+}
@@ -0,0 +1,38 @@
+#include "EntityStore.h"
+
+#ifndef ANIMATION_SET_H
+#define ANIMATION_SET_H
+
+// The atlas frames played while facing one direction
+struct AnimationClip
+{
+    const int *frames;
+    int        frameCount;
+};
+
+// A direction -> frames atlas compiled into one flat frame array with a clip
+// per Direction. Missing directions fall back to RIGHT, then to the first
+// direction present, so a lookup is a plain array index. Sets are immutable
+// and shared: get them through internAnimationSet().
+class AnimationSet
+{
+private:
+    static constexpr int DIRECTION_COUNT = NEUTRAL + 1;
+
+    std::vector<int> mFrames;
+    AnimationClip    mClips[DIRECTION_COUNT];
+
+public:
+    explicit AnimationSet(const std::map<Direction, std::vector<int>> &atlas);
+
+    AnimationSet(const AnimationSet &) = delete;
+    AnimationSet &operator=(const AnimationSet &) = delete;
+
+    const AnimationClip &getClip(Direction direction) const { return mClips[direction]; }
+};
+
+// Returns the shared compiled set for this atlas, compiling it on first use.
+// Call at load time; the returned set lives until the program exits.
+const AnimationSet *internAnimationSet(const std::map<Direction, std::vector<int>> &atlas);
+
+#endif // ANIMATION_SET_H
@@ -0,0 +1,293 @@
+#include "AssetCache.h"
+
+AssetCache gAssetCache;
+
+Texture2D AssetCache::acquireTexture(const char *filePath)
+{
+    auto it = mTextures.find(filePath);
+    if (it != mTextures.end())
+    {
+        it->second.refCount++;
+        return it->second.asset;
+    }
+
+    Texture2D texture = LoadTexture(filePath);
+    if (texture.id == 0)
+    {
+        printf("AssetCache: failed to load texture '%s'\n", filePath);
+        return texture;
+    }
+
+    return adoptTexture(filePath, texture);
+}
+
+Texture2D AssetCache::adoptTexture(const char *filePath, Texture2D texture)
+{
+    if (texture.id == 0) return texture;
+
+    mTextures[filePath] = { texture, 1 };
+    mTexturePaths[texture.id] = filePath;
+
+    return texture;
+}
+
+void AssetCache::releaseTexture(Texture2D texture)
+{
+    if (texture.id == 0) return;
+
+    auto pathIt = mTexturePaths.find(texture.id);
+    if (pathIt == mTexturePaths.end())
+    {
+        printf("AssetCache: released texture %u that it does not own\n", texture.id);
+        return;
+    }
+
+    auto it = mTextures.find(pathIt->second);
+    if (--it->second.refCount > 0) return;
+
+    UnloadTexture(it->second.asset);
+    mTextures.erase(it);
+    mTexturePaths.erase(pathIt);
+}
+
+Sound AssetCache::acquireSound(const char *filePath)
+{
+    auto it = mSounds.find(filePath);
+    if (it != mSounds.end())
+    {
+        it->second.refCount++;
+        return it->second.asset;
+    }
+
+    Sound sound = LoadSound(filePath);
+    if (sound.frameCount == 0)
+    {
+        printf("AssetCache: failed to load sound '%s'\n", filePath);
+        return sound;
+    }
+
+    mSounds[filePath] = { sound, 1 };
+    mSoundPaths[sound.stream.buffer] = filePath;
+
+    return sound;
+}
+
+void AssetCache::releaseSound(Sound sound)
+{
+    if (sound.frameCount == 0) return;
+
+    auto pathIt = mSoundPaths.find(sound.stream.buffer);
+    if (pathIt == mSoundPaths.end()) return;
+
+    auto it = mSounds.find(pathIt->second);
+    if (--it->second.refCount > 0) return;
+
+    UnloadSound(it->second.asset);
+    mSounds.erase(it);
+    mSoundPaths.erase(pathIt);
+}
+
+Music AssetCache::acquireMusic(const char *filePath)
+{
+    auto it = mMusic.find(filePath);
+    if (it != mMusic.end())
+    {
+        it->second.refCount++;
+        return it->second.asset;
+    }
+
+    Music music = LoadMusicStream(filePath);
+    if (music.ctxData == nullptr)
+    {
+        printf("AssetCache: failed to load music '%s'\n", filePath);
+        return music;
+    }
+
+    mMusic[filePath] = { music, 1 };
+    mMusicPaths[music.ctxData] = filePath;
+
+    return music;
+}
+
+void AssetCache::releaseMusic(Music music)
+{
+    if (music.ctxData == nullptr) return;
+
+    auto pathIt = mMusicPaths.find(music.ctxData);
+    if (pathIt == mMusicPaths.end()) return;
+
+    auto it = mMusic.find(pathIt->second);
+    if (--it->second.refCount > 0) return;
+
+    unloadMusicEntry(it->second.asset);
+    mMusic.erase(it);
+    mMusicPaths.erase(pathIt);
+}
+
+void AssetCache::unloadMusicEntry(const Music &music)
+{
+    const void *context = music.ctxData;
+    UnloadMusicStream(music);
+
+    // Streams opened from prefetched bytes read them until unloaded
+    auto dataIt = mMusicData.find(context);
+    if (dataIt != mMusicData.end())
+    {
+        UnloadFileData(dataIt->second);
+        mMusicData.erase(dataIt);
+    }
+}
+
+void AssetCache::retainManifest(const AssetManifest &manifest)
+{
+    for (const std::string &path : manifest.textures) acquireTexture(path.c_str());
+    for (const std::string &path : manifest.sounds)   acquireSound(path.c_str());
+    for (const std::string &path : manifest.music)    acquireMusic(path.c_str());
+}
+
+void AssetCache::releaseManifest(const AssetManifest &manifest)
+{
+    for (const std::string &path : manifest.textures)
+    {
+        auto it = mTextures.find(path);
+        if (it != mTextures.end()) releaseTexture(it->second.asset);
+    }
+    for (const std::string &path : manifest.sounds)
+    {
+        auto it = mSounds.find(path);
+        if (it != mSounds.end()) releaseSound(it->second.asset);
+    }
+    for (const std::string &path : manifest.music)
+    {
+        auto it = mMusic.find(path);
+        if (it != mMusic.end()) releaseMusic(it->second.asset);
+    }
+}
+
+void AssetCache::prefetch(const AssetManifest &manifest)
+{
+    // One batch at a time; anything still in flight is finished first
+    finishPrefetch();
+
+    // Work out what is missing here, so the worker never reads the cache maps
+    AssetManifest missing;
+    for (const std::string &path : manifest.textures)
+        if (mTextures.find(path) == mTextures.end()) missing.textures.push_back(path);
+    for (const std::string &path : manifest.sounds)
+        if (mSounds.find(path) == mSounds.end()) missing.sounds.push_back(path);
+    for (const std::string &path : manifest.music)
+        if (mMusic.find(path) == mMusic.end()) missing.music.push_back(path);
+
+    if (missing.textures.empty() && missing.sounds.empty() && missing.music.empty()) return;
+
+    mPrefetchThread = std::thread([this, missing]()
+    {
+        // Decoding only: no GL or audio device calls on this thread
+        for (const std::string &path : missing.textures)
+        {
+            Image image = LoadImage(path.c_str());
+            std::lock_guard<std::mutex> lock(mPrefetchMutex);
+            mDecodedImages.push_back({ path, image });
+        }
+        for (const std::string &path : missing.sounds)
+        {
+            Wave wave = LoadWave(path.c_str());
+            std::lock_guard<std::mutex> lock(mPrefetchMutex);
+            mDecodedWaves.push_back({ path, wave });
+        }
+        for (const std::string &path : missing.music)
+        {
+            int size = 0;
+            unsigned char *data = LoadFileData(path.c_str(), &size);
+            std::lock_guard<std::mutex> lock(mPrefetchMutex);
+            mLoadedMusic.push_back({ path, data, size });
+        }
+    });
+}
+
+void AssetCache::uploadPrefetched()
+{
+    std::vector<DecodedImage> images;
+    std::vector<DecodedWave>  waves;
+    std::vector<LoadedFile>   files;
+    {
+        std::lock_guard<std::mutex> lock(mPrefetchMutex);
+        images.swap(mDecodedImages);
+        waves.swap(mDecodedWaves);
+        files.swap(mLoadedMusic);
+    }
+
+    // Assets acquired the slow way while the worker was busy are skipped
+    for (DecodedImage &decoded : images)
+    {
+        if (decoded.image.data != nullptr && mTextures.find(decoded.path) == mTextures.end())
+        {
+            Texture2D texture = LoadTextureFromImage(decoded.image);
+            if (texture.id != 0)
+            {
+                mTextures[decoded.path] = { texture, 0 };
+                mTexturePaths[texture.id] = decoded.path;
+            }
+        }
+        UnloadImage(decoded.image);
+    }
+
+    for (DecodedWave &decoded : waves)
+    {
+        if (decoded.wave.data != nullptr && mSounds.find(decoded.path) == mSounds.end())
+        {
+            Sound sound = LoadSoundFromWave(decoded.wave);
+            if (sound.frameCount != 0)
+            {
+                mSounds[decoded.path] = { sound, 0 };
+                mSoundPaths[sound.stream.buffer] = decoded.path;
+            }
+        }
+        UnloadWave(decoded.wave);
+    }
+
+    for (LoadedFile &file : files)
+    {
+        Music music = {};
+        if (file.data != nullptr && mMusic.find(file.path) == mMusic.end())
+        {
+            music = LoadMusicStreamFromMemory(GetFileExtension(file.path.c_str()), file.data, file.size);
+        }
+
+        if (music.ctxData != nullptr)
+        {
+            mMusic[file.path] = { music, 0 };
+            mMusicPaths[music.ctxData] = file.path;
+            mMusicData[music.ctxData]  = file.data;
+        }
+        else if (file.data != nullptr) UnloadFileData(file.data);
+    }
+}
+
+void AssetCache::finishPrefetch()
+{
+    if (mPrefetchThread.joinable()) mPrefetchThread.join();
+    uploadPrefetched();
+}
+
+AssetCache::~AssetCache()
+{
+    // The device is gone by now; just make sure the worker is not left running
+    if (mPrefetchThread.joinable()) mPrefetchThread.join();
+}
+
+void AssetCache::unloadAll()
+{
+    finishPrefetch();
+
+    for (auto &entry : mTextures) UnloadTexture(entry.second.asset);
+    for (auto &entry : mSounds)   UnloadSound(entry.second.asset);
+    for (auto &entry : mMusic)    unloadMusicEntry(entry.second.asset);
+
+    mTextures.clear();
+    mTexturePaths.clear();
+    mSounds.clear();
+    mSoundPaths.clear();
+    mMusic.clear();
+    mMusicPaths.clear();
+}
@@ -0,0 +1,103 @@
+#include "cs3113.h"
+#include <thread>
+#include <mutex>
+
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+// The files a scene needs while it is active. Holding a manifest keeps all
+// of its assets resident, so re-entering the scene touches no disk.
+struct AssetManifest
+{
+    std::vector<std::string> textures;
+    std::vector<std::string> sounds;
+    std::vector<std::string> music;
+};
+
+// Reference-counted store of GPU textures and audio keyed by file path.
+// Every acquire must be paired with a release; an asset is unloaded when
+// the last holder lets go, so a file is decoded and uploaded once no
+// matter how many entities or scenes use it.
+class AssetCache
+{
+private:
+    template <typename T>
+    struct Entry
+    {
+        T   asset;
+        int refCount;
+    };
+
+    std::map<std::string, Entry<Texture2D>> mTextures;     // path -> texture
+    std::map<unsigned int, std::string>     mTexturePaths; // GL id -> path
+
+    std::map<std::string, Entry<Sound>>     mSounds;       // path -> sound
+    std::map<const void*, std::string>      mSoundPaths;   // audio buffer -> path
+
+    std::map<std::string, Entry<Music>>     mMusic;        // path -> music stream
+    std::map<const void*, std::string>      mMusicPaths;   // decoder context -> path
+    std::map<const void*, unsigned char*>   mMusicData;    // decoder context -> file bytes
+                                                           // (prefetched streams read from memory)
+
+    // Background prefetch: a worker thread decodes files into CPU memory and
+    // queues them; the main thread uploads them (GPU/audio work stays there)
+    struct DecodedImage { std::string path; Image image; };
+    struct DecodedWave  { std::string path; Wave  wave;  };
+    struct LoadedFile   { std::string path; unsigned char *data; int size; };
+
+    std::thread               mPrefetchThread;
+    std::mutex                mPrefetchMutex;
+    std::vector<DecodedImage> mDecodedImages;
+    std::vector<DecodedWave>  mDecodedWaves;
+    std::vector<LoadedFile>   mLoadedMusic;
+
+    void unloadMusicEntry(const Music &music);
+
+public:
+    // Returns the cached texture for path, loading it on first use.
+    // A failed load returns an empty texture (id 0) and is not cached.
+    Texture2D acquireTexture(const char *filePath);
+
+    // Registers a texture created elsewhere (e.g. a generated fallback) under
+    // filePath with one reference, so later acquires/releases treat it alike
+    Texture2D adoptTexture(const char *filePath, Texture2D texture);
+
+    // Drops one reference; unloads the texture when none remain
+    void releaseTexture(Texture2D texture);
+
+    // Sounds and music streams follow the same rules as textures. A failed
+    // load returns an empty handle (frameCount 0 / ctxData nullptr).
+    Sound acquireSound(const char *filePath);
+    void  releaseSound(Sound sound);
+    Music acquireMusic(const char *filePath);
+    void  releaseMusic(Music music);
+
+    // Takes / drops one reference on every asset in the manifest
+    void retainManifest(const AssetManifest &manifest);
+    void releaseManifest(const AssetManifest &manifest);
+
+    // Starts decoding, on a worker thread, every asset in the manifest that
+    // is not cached yet. Decoded assets enter the cache with no references
+    // once uploaded, so the next acquire is a cache hit.
+    void prefetch(const AssetManifest &manifest);
+
+    // Main thread: uploads whatever the worker has finished so far
+    void uploadPrefetched();
+
+    // Main thread: waits for the worker and uploads everything it decoded
+    void finishPrefetch();
+
+    // Unloads everything still cached. Call before CloseAudioDevice() and
+    // CloseWindow().
+    void unloadAll();
+
+    ~AssetCache();
+
+    int getTextureCount() const { return (int) mTextures.size(); }
+    int getSoundCount()   const { return (int) mSounds.size();   }
+    int getMusicCount()   const { return (int) mMusic.size();    }
+};
+
+extern AssetCache gAssetCache;
+
+#endif // ASSET_CACHE_H
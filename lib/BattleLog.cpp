@@ -0,0 +1,74 @@
+#include "BattleLog.h"
+#include <stdio.h>
+
+void BattleLog::clear()
+{
+    mCount     = 0;
+    mFormatted = -1;
+    mText[0]   = '\0';
+}
+
+void BattleLog::message(const char *text)
+{
+    // Scenes re-post banners like "VICTORY!" every frame; keep one line
+    if (mCount > 0 && getEntry(0).type == LOG_MESSAGE && getEntry(0).message == text) return;
+    add(LOG_MESSAGE, NO_COMBATANT);
+    mEntries[(mCount - 1) % CAPACITY].message = text;
+}
+
+void BattleLog::add(BattleLogType type, CombatantHandle actor, CombatantHandle target, int amount)
+{
+    BattleLogEntry &entry = mEntries[mCount % CAPACITY];
+    entry.type    = type;
+    entry.message = nullptr;
+    entry.actor   = actor;
+    entry.target  = target;
+    entry.amount  = amount;
+    mCount++;
+}
+
+int BattleLog::getCount() const
+{
+    return mCount < CAPACITY ? mCount : CAPACITY;
+}
+
+const BattleLogEntry &BattleLog::getEntry(int age) const
+{
+    return mEntries[(mCount - 1 - age) % CAPACITY];
+}
+
+void BattleLog::format(const BattleLogEntry &entry, const std::vector<Combatant> &party,
+                       const std::vector<Combatant> &enemies, char *buffer, int size)
+{
+    const char *actor  = entry.actor  != NO_COMBATANT ? getCombatant(party, enemies, entry.actor).name.c_str()  : "";
+    const char *target = entry.target != NO_COMBATANT ? getCombatant(party, enemies, entry.target).name.c_str() : "";
+
+    switch (entry.type)
+    {
+        case LOG_MESSAGE:      snprintf(buffer, size, "%s", entry.message ? entry.message : ""); break;
+        case LOG_TURN:         snprintf(buffer, size, "%s's Turn!", actor); break;
+        case LOG_ENEMY_ATTACK: snprintf(buffer, size, "%s attacks %s!", actor, target); break;
+        case LOG_HIT:          snprintf(buffer, size, "Hit! Dealt %d damage.", entry.amount); break;
+        case LOG_ONE_MORE:     snprintf(buffer, size, "WEAKNESS! 1 More!"); break;
+        case LOG_AMMO:
+            snprintf(buffer, size, "Ammo left: %d / %d", entry.amount,
+                getCombatant(party, enemies, entry.actor).gunWeapon.magazineSize);
+            break;
+        case LOG_GUARD:        snprintf(buffer, size, "%s is Guarding...", actor); break;
+        case LOG_HEAL:         snprintf(buffer, size, "Healed %s for %d HP!", target, entry.amount); break;
+        case LOG_RESTORE_SP:   snprintf(buffer, size, "Restored %d SP to %s!", entry.amount, target); break;
+        case LOG_REVIVE:       snprintf(buffer, size, "Revived %s to %d HP!", target, entry.amount); break;
+        case LOG_NO_EFFECT:    snprintf(buffer, size, "%s is already alive.", target); break;
+    }
+}
+
+const char *BattleLog::latest(const std::vector<Combatant> &party, const std::vector<Combatant> &enemies)
+{
+    if (mCount == 0) return "";
+    if (mFormatted != mCount)
+    {
+        format(getEntry(0), party, enemies, mText, TEXT_SIZE);
+        mFormatted = mCount;
+    }
+    return mText;
+}
@@ -0,0 +1,63 @@
+#include "CombatRules.h"
+#include <vector>
+
+#ifndef BATTLE_LOG_H
+#define BATTLE_LOG_H
+
+// What a battle log line says. Entries keep handles and numbers; names and
+// text are only filled in when the line is shown.
+enum BattleLogType
+{
+    LOG_MESSAGE,      // fixed text
+    LOG_TURN,         // "<actor>'s Turn!"
+    LOG_ENEMY_ATTACK, // "<actor> attacks <target>!"
+    LOG_HIT,          // "Hit! Dealt <amount> damage."
+    LOG_ONE_MORE,
+    LOG_AMMO,         // rounds left (amount) out of the actor's magazine
+    LOG_GUARD,
+    LOG_HEAL,
+    LOG_RESTORE_SP,
+    LOG_REVIVE,
+    LOG_NO_EFFECT
+};
+
+struct BattleLogEntry
+{
+    BattleLogType   type;
+    const char     *message; // LOG_MESSAGE only; must outlive the log (use literals)
+    CombatantHandle actor;
+    CombatantHandle target;
+    int             amount;
+};
+
+// The battle's recent lines in a fixed ring, so logging an action never
+// allocates or formats. The newest line is turned into text when it is
+// drawn, and only once per line.
+class BattleLog
+{
+public:
+    static const int CAPACITY  = 16;
+    static const int TEXT_SIZE = 128;
+
+private:
+    BattleLogEntry mEntries[CAPACITY];
+    int  mCount     = 0;  // lines ever added; the ring keeps the newest
+    int  mFormatted = -1; // mCount when mText was last formatted
+    char mText[TEXT_SIZE] = "";
+
+public:
+    void clear();
+    void message(const char *text);
+    void add(BattleLogType type, CombatantHandle actor, CombatantHandle target = NO_COMBATANT, int amount = 0);
+
+    int getCount() const; // lines held, up to CAPACITY
+    const BattleLogEntry &getEntry(int age) const; // 0 = newest
+
+    static void format(const BattleLogEntry &entry, const std::vector<Combatant> &party,
+                       const std::vector<Combatant> &enemies, char *buffer, int size);
+
+    // The newest line as text ("" when empty)
+    const char *latest(const std::vector<Combatant> &party, const std::vector<Combatant> &enemies);
+};
+
+#endif // BATTLE_LOG_H
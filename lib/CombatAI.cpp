@@ -0,0 +1,266 @@
+#include "CombatAI.h"
+#include <algorithm>
+#include <climits>
+
+// Scores are from the enemies' side: higher is better for them
+static const int WIN_SCORE       = 100000;
+static const int KO_VALUE        = 200;
+static const int DOWN_PENALTY    = 60;  // a downed enemy is a step towards a hold up
+static const int WEAKNESS_THREAT = 40;  // per party member who can earn a 1 More
+
+// From `combat_sim --surprise` sweeps with the greedy policy: a caught party
+// wins about 46% of Level 1 fights at 0.1 and 86% of Level 2 fights at 0.35
+float getEnemyCunning(int levelIndex)
+{
+    if (levelIndex == 0) return 0.1f;  // Level 1 Shadows are careless
+    if (levelIndex == 1) return 0.35f;
+    return 1.0f;                       // the boss always plays its best move
+}
+
+CombatAI::Snapshot CombatAI::takeSnapshot(const Combatant &c)
+{
+    Snapshot s;
+    s.hp = c.currentHp; s.sp = c.currentSp; s.ammo = c.currentAmmo;
+    s.isAlive = c.isAlive; s.isDown = c.isDown; s.hasActed = c.hasActed; s.isGuarding = c.isGuarding;
+    return s;
+}
+
+void CombatAI::applySnapshot(Combatant &c, const Snapshot &s)
+{
+    c.currentHp = s.hp; c.currentSp = s.sp; c.currentAmmo = s.ammo;
+    c.isAlive = s.isAlive; c.isDown = s.isDown; c.hasActed = s.hasActed; c.isGuarding = s.isGuarding;
+}
+
+void CombatAI::save(int depth)
+{
+    Snapshot *saved = mSaved[depth];
+    for (int i = 0; i < (int) mParty.size(); i++)   saved[i]            = takeSnapshot(mParty[i]);
+    for (int i = 0; i < (int) mEnemies.size(); i++) saved[MAX_SIDE + i] = takeSnapshot(mEnemies[i]);
+}
+
+void CombatAI::restore(int depth)
+{
+    const Snapshot *saved = mSaved[depth];
+    for (int i = 0; i < (int) mParty.size(); i++)   applySnapshot(mParty[i], saved[i]);
+    for (int i = 0; i < (int) mEnemies.size(); i++) applySnapshot(mEnemies[i], saved[MAX_SIDE + i]);
+}
+
+void CombatAI::beginBattle(const std::vector<Combatant> &party, const std::vector<Combatant> &enemies)
+{
+    mParty   = party;
+    mEnemies = enemies;
+}
+
+int CombatAI::generateMoves(CombatTurn turn, CombatAction *moves) const
+{
+    int count = 0;
+
+    if (turn.phase == PHASE_ENEMY)
+    {
+        for (int p = 0; p < (int) mParty.size(); p++)
+        {
+            if (!mParty[p].isAlive) continue;
+            CombatAction &attack = moves[count++];
+            attack        = CombatAction(ACTION_ENEMY_ATTACK);
+            attack.actor  = enemyHandle(turn.slot);
+            attack.target = partyHandle(p);
+        }
+        return count;
+    }
+
+    const Combatant &actor = mParty[turn.slot];
+    for (int e = 0; e < (int) mEnemies.size() && count + 2 + (int) actor.skills.size() <= MAX_MOVES; e++)
+    {
+        if (!mEnemies[e].isAlive) continue;
+
+        CombatAction attack(ACTION_MELEE);
+        attack.actor  = partyHandle(turn.slot);
+        attack.target = enemyHandle(e);
+        moves[count++] = attack;
+
+        if (actor.currentAmmo > 0)
+        {
+            attack.type = ACTION_GUN;
+            moves[count++] = attack;
+        }
+
+        attack.type = ACTION_SKILL;
+        for (int s = 0; s < (int) actor.skills.size(); s++)
+        {
+            const Ability &skill = actor.skills[s];
+            if (skill.damage <= 0 || !canAfford(actor, skill)) continue;
+            attack.skill = s;
+            moves[count++] = attack;
+        }
+    }
+
+    // Heals only go to whoever is hurt most
+    int hurt = -1;
+    for (int p = 0; p < (int) mParty.size(); p++)
+    {
+        const Combatant &m = mParty[p];
+        if (!m.isAlive || m.currentHp >= m.maxHp) continue;
+        if (hurt < 0 || m.currentHp * mParty[hurt].maxHp < mParty[hurt].currentHp * m.maxHp) hurt = p;
+    }
+    for (int s = 0; s < (int) actor.skills.size() && hurt >= 0 && count < MAX_MOVES - 1; s++)
+    {
+        const Ability &skill = actor.skills[s];
+        if (skill.damage >= 0 || !canAfford(actor, skill)) continue;
+        CombatAction heal(ACTION_SKILL);
+        heal.actor  = partyHandle(turn.slot);
+        heal.target = partyHandle(hurt);
+        heal.skill  = s;
+        moves[count++] = heal;
+    }
+
+    CombatAction guard(ACTION_GUARD);
+    guard.actor = partyHandle(turn.slot);
+    moves[count++] = guard;
+    return count;
+}
+
+// Plays a move in the scene's turn order and returns who moves next
+CombatTurn CombatAI::play(CombatTurn turn, const CombatAction &move, CombatEvents &events)
+{
+    resolveAction(mParty, mEnemies, move, events);
+    applyEvents(mParty, mEnemies, events);
+    CombatTurn next = advanceTurn(mParty, mEnemies, turn, events);
+    if (next.phase != PHASE_HOLD_UP) return next;
+
+    // Assume the player never turns down an all-out attack
+    CombatAction allOut(ACTION_ALL_OUT);
+    allOut.actor = partyHandle(next.slot);
+    resolveAction(mParty, mEnemies, allOut, events);
+    applyEvents(mParty, mEnemies, events);
+    return advanceTurn(mParty, mEnemies, next, events);
+}
+
+int CombatAI::search(CombatTurn turn, int depth, int alpha, int beta)
+{
+    mNodes++;
+    // Sooner wins (and later losses) score higher
+    if (isPartyDefeated(mParty)) return WIN_SCORE + depth;
+    if (!anyAlive(mEnemies))     return -WIN_SCORE - depth;
+    if (depth == 0 || mNodes >= mNodeLimit) return evaluate();
+
+    CombatAction moves[MAX_MOVES];
+    int count = generateMoves(turn, moves);
+    if (count == 0) return evaluate();
+
+    // Enemies maximise the score, the party minimises it
+    save(depth);
+    bool enemiesMove = turn.phase == PHASE_ENEMY;
+    int best = enemiesMove ? INT_MIN : INT_MAX;
+    for (int i = 0; i < count; i++)
+    {
+        CombatTurn next = play(turn, moves[i], mEvents[depth]);
+        int score = search(next, depth - 1, alpha, beta);
+        restore(depth);
+
+        if (enemiesMove)
+        {
+            best  = std::max(best, score);
+            alpha = std::max(alpha, score);
+        }
+        else
+        {
+            best = std::min(best, score);
+            beta = std::min(beta, score);
+        }
+        if (alpha >= beta) break;
+    }
+    return best;
+}
+
+int CombatAI::evaluate() const
+{
+    int score = 0;
+    for (const Combatant &member : mParty)
+    {
+        if (!member.isAlive) { score += KO_VALUE; continue; }
+        score += (member.maxHp - member.currentHp) * 100 / std::max(1, member.maxHp);
+
+        // Anyone who can knock a standing enemy down gets a 1 More out of it
+        bool isThreat = false;
+        for (int e = 0; e < (int) mEnemies.size() && !isThreat; e++)
+        {
+            const Combatant &enemy = mEnemies[e];
+            if (!enemy.isAlive || enemy.isDown) continue;
+            if (isWeakTo(enemy, PHYS) || (member.currentAmmo > 0 && isWeakTo(enemy, GUN))) isThreat = true;
+            for (const Ability &skill : member.skills)
+                if (skill.damage > 0 && canAfford(member, skill) && isWeakTo(enemy, skill.element)) isThreat = true;
+        }
+        if (isThreat) score -= WEAKNESS_THREAT;
+    }
+    for (const Combatant &enemy : mEnemies)
+    {
+        if (!enemy.isAlive) { score -= KO_VALUE; continue; }
+        score -= (enemy.maxHp - enemy.currentHp) * 100 / std::max(1, enemy.maxHp);
+        if (enemy.isDown) score -= DOWN_PENALTY;
+    }
+    return score;
+}
+
+CombatAction CombatAI::chooseAction(const std::vector<Combatant> &party, const std::vector<Combatant> &enemies,
+                                    int enemy, RandomStream &rng)
+{
+    CombatAction attack(ACTION_ENEMY_ATTACK);
+    attack.actor = enemyHandle(enemy);
+    mNodes = 0;
+
+    int living = 0;
+    for (const Combatant &member : party)
+        if (member.isAlive) living++;
+    if (living == 0) return attack;
+
+    // A careless swing still never picks a fallen ally
+    bool careless = mCunning < 1.0f && rng.nextFloat() >= mCunning;
+    if (careless || (int) party.size() > MAX_SIDE || (int) enemies.size() > MAX_SIDE)
+    {
+        int pick = careless ? rng.range(0, living - 1) : 0;
+        for (int p = 0; p < (int) party.size(); p++)
+        {
+            if (!party[p].isAlive) continue;
+            if (pick-- == 0) { attack.target = partyHandle(p); break; }
+        }
+        return attack;
+    }
+
+    // A lineup beginBattle was not told about gets a full copy
+    bool sameLineup = mParty.size() == party.size() && mEnemies.size() == enemies.size();
+    for (int i = 0; i < (int) party.size() && sameLineup; i++)   sameLineup = mParty[i].id == party[i].id;
+    for (int i = 0; i < (int) enemies.size() && sameLineup; i++) sameLineup = mEnemies[i].id == enemies[i].id;
+    if (!sameLineup) beginBattle(party, enemies);
+    for (int i = 0; i < (int) party.size(); i++)   applySnapshot(mParty[i], takeSnapshot(party[i]));
+    for (int i = 0; i < (int) enemies.size(); i++) applySnapshot(mEnemies[i], takeSnapshot(enemies[i]));
+
+    CombatTurn turn = { PHASE_ENEMY, enemy };
+    CombatAction moves[MAX_MOVES];
+    int count = generateMoves(turn, moves);
+
+    // Deepen one action at a time; a depth cut short by the node limit
+    // only counts if it is the first
+    int best = 0;
+    for (int depth = 1; depth <= MAX_DEPTH; depth++)
+    {
+        int bestAtDepth = 0;
+        int bestScore   = INT_MIN;
+        bool complete   = true;
+
+        save(depth);
+        for (int i = 0; i < count; i++)
+        {
+            CombatTurn next = play(turn, moves[i], mEvents[depth]);
+            int score = search(next, depth - 1, bestScore, INT_MAX);
+            restore(depth);
+
+            if (mNodes >= mNodeLimit) complete = false;
+            if (score > bestScore) { bestScore = score; bestAtDepth = i; }
+            if (!complete) break;
+        }
+
+        if (complete || depth == 1) best = bestAtDepth;
+        if (!complete) break;
+    }
+    return moves[best];
+}
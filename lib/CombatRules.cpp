@@ -0,0 +1,369 @@
+#include "CombatRules.h"
+#include "GameData.h"
+#include <algorithm>
+
+static const Ability MELEE_ATTACK = { "Melee", 0, 0, PHYS, false };
+static const Ability GUN_ATTACK   = { "Gun",   0, 0, GUN,  false };
+
+void CombatEvents::push(CombatEventType type, CombatantHandle actor, CombatantHandle target, int amount, bool isWeakness)
+{
+    if (count >= CAPACITY)
+    {
+        printf("CombatEvents: more than %d events in one action, dropping\n", CAPACITY);
+        return;
+    }
+    CombatEvent &event = events[count++];
+    event.type       = type;
+    event.actor      = actor;
+    event.target     = target;
+    event.amount     = amount;
+    event.isWeakness = isWeakness;
+}
+
+bool CombatEvents::contains(CombatEventType type) const
+{
+    for (int i = 0; i < count; i++)
+        if (events[i].type == type) return true;
+    return false;
+}
+
+Combatant &getCombatant(std::vector<Combatant> &party, std::vector<Combatant> &enemies, CombatantHandle handle)
+{
+    return isEnemyHandle(handle) ? enemies[handle - ENEMY_HANDLE_BASE] : party[handle];
+}
+
+const Combatant &getCombatant(const std::vector<Combatant> &party, const std::vector<Combatant> &enemies,
+                              CombatantHandle handle)
+{
+    return isEnemyHandle(handle) ? enemies[handle - ENEMY_HANDLE_BASE] : party[handle];
+}
+
+// A party member's attack on an enemy. roundsLeft >= 0 for gunfire.
+static void resolveAttack(const Combatant &attacker, CombatantHandle actor, const Combatant &defender,
+                          CombatantHandle target, const Ability &skill, int roundsLeft, CombatEvents &events)
+{
+    bool isWeakness = isWeakTo(defender, skill.element);
+    int  damage     = computeDamage(attacker, defender, skill, isWeakness);
+    events.push(EVENT_DAMAGE, actor, target, damage, isWeakness);
+
+    bool isKill = defender.currentHp - damage <= 0;
+    // Knocking a standing enemy down grants one more action
+    bool isOneMore = isWeakness && !isKill && !defender.isDown;
+    if (isKill) events.push(EVENT_KO, actor, target);
+    if (isOneMore)
+    {
+        events.push(EVENT_DOWN, actor, target);
+        events.push(EVENT_ONE_MORE, actor, actor);
+    }
+
+    // Shots keep the turn until the magazine is empty
+    bool isRapidFire = roundsLeft > 0;
+    if (isRapidFire) events.push(EVENT_RAPID_FIRE, actor, actor, roundsLeft);
+    if (!isOneMore && !isRapidFire) events.push(EVENT_TURN_END, actor, actor);
+}
+
+void resolveAction(const std::vector<Combatant> &party, const std::vector<Combatant> &enemies,
+                   const CombatAction &action, CombatEvents &events)
+{
+    events.clear();
+    if (action.actor == NO_COMBATANT) return;
+
+    if (action.type == ACTION_ENEMY_ATTACK)
+    {
+        if (action.target == NO_COMBATANT) return;
+        const Combatant &enemy  = getCombatant(party, enemies, action.actor);
+        const Combatant &target = getCombatant(party, enemies, action.target);
+        if (!target.isAlive) return;
+
+        // Shadows hit for their attack stat; guarding halves it
+        int damage = enemy.baseAttack;
+        if (target.isGuarding) damage = (int)(damage * 0.5f);
+        events.push(EVENT_DAMAGE, action.actor, action.target, damage);
+        if (target.currentHp - damage <= 0) events.push(EVENT_KO, action.actor, action.target);
+        return;
+    }
+
+    const Combatant &actor = getCombatant(party, enemies, action.actor);
+    switch (action.type)
+    {
+        case ACTION_MELEE:
+            resolveAttack(actor, action.actor, getCombatant(party, enemies, action.target), action.target,
+                MELEE_ATTACK, -1, events);
+            break;
+
+        case ACTION_GUN:
+        {
+            int rounds = actor.currentAmmo;
+            if (rounds > 0)
+            {
+                events.push(EVENT_SHOT, action.actor, action.actor, 1);
+                rounds--;
+            }
+            resolveAttack(actor, action.actor, getCombatant(party, enemies, action.target), action.target,
+                GUN_ATTACK, rounds, events);
+            break;
+        }
+
+        case ACTION_SKILL:
+        {
+            const Ability &skill = actor.skills[action.skill];
+            events.push(skill.isMagic ? EVENT_SPEND_SP : EVENT_SPEND_HP, action.actor, action.actor, skill.cost);
+
+            if (skill.damage < 0)
+            {
+                events.push(EVENT_HEAL, action.actor, action.target, -skill.damage);
+                events.push(EVENT_TURN_END, action.actor, action.actor);
+            }
+            else resolveAttack(actor, action.actor, getCombatant(party, enemies, action.target), action.target,
+                skill, -1, events);
+            break;
+        }
+
+        case ACTION_ITEM:
+        {
+            const Item &item = *action.item;
+            const Combatant &target = getCombatant(party, enemies, action.target);
+            if (item.isRevive)
+            {
+                if (target.isAlive) events.push(EVENT_NO_EFFECT, action.actor, action.target);
+                else events.push(EVENT_REVIVE, action.actor, action.target, std::min(item.value, target.maxHp));
+            }
+            else if (item.isSP) events.push(EVENT_RESTORE_SP, action.actor, action.target, item.value);
+            else events.push(EVENT_HEAL, action.actor, action.target, item.value);
+            // The item is used up either way
+            events.push(EVENT_TURN_END, action.actor, action.actor);
+            break;
+        }
+
+        case ACTION_GUARD:
+            events.push(EVENT_GUARD, action.actor, action.actor);
+            events.push(EVENT_TURN_END, action.actor, action.actor);
+            break;
+
+        case ACTION_ALL_OUT:
+        {
+            // 100 damage to every living enemy; anyone left under 50 HP is
+            // executed, and survivors get up so it cannot chain into another hold up
+            bool survivors = false;
+            for (int i = 0; i < (int) enemies.size(); i++)
+            {
+                if (!enemies[i].isAlive) continue;
+                events.push(EVENT_DAMAGE, action.actor, enemyHandle(i), 100);
+                if (enemies[i].currentHp - 100 < 50) events.push(EVENT_KO, action.actor, enemyHandle(i));
+                else
+                {
+                    events.push(EVENT_STAND_UP, action.actor, enemyHandle(i));
+                    survivors = true;
+                }
+            }
+            // Consumes the actor's turn if the battle goes on
+            if (survivors) events.push(EVENT_TURN_END, action.actor, action.actor);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void applyEvents(std::vector<Combatant> &party, std::vector<Combatant> &enemies, const CombatEvents &events)
+{
+    for (int i = 0; i < events.count; i++)
+    {
+        const CombatEvent &event = events[i];
+        Combatant &actor  = getCombatant(party, enemies, event.actor);
+        Combatant &target = getCombatant(party, enemies, event.target);
+
+        switch (event.type)
+        {
+            case EVENT_SPEND_SP:   actor.currentSp -= event.amount; break;
+            case EVENT_SPEND_HP:   actor.currentHp -= event.amount; break;
+            case EVENT_SHOT:       actor.currentAmmo -= event.amount; break;
+            case EVENT_DAMAGE:     target.currentHp = std::max(0, target.currentHp - event.amount); break;
+            case EVENT_KO:         target.currentHp = 0; target.isAlive = false; target.isDown = true; break;
+            case EVENT_DOWN:       target.isDown = true;  break;
+            case EVENT_STAND_UP:   target.isDown = false; break;
+            case EVENT_ONE_MORE:
+            case EVENT_RAPID_FIRE: actor.hasActed = false; break;
+            case EVENT_TURN_END:   actor.hasActed = true;  break;
+            case EVENT_GUARD:      actor.isGuarding = true; break;
+            case EVENT_HEAL:       target.currentHp = std::min(target.currentHp + event.amount, target.maxHp); break;
+            case EVENT_RESTORE_SP: target.currentSp = std::min(target.currentSp + event.amount, target.maxSp); break;
+            case EVENT_REVIVE:     target.isAlive = true; target.isDown = false; target.currentHp = event.amount; break;
+            case EVENT_NO_EFFECT:  break;
+        }
+    }
+}
+
+std::vector<Combatant> rollEncounter(int levelIndex, RandomStream &rng)
+{
+    std::vector<Combatant> enemies;
+
+    // Final level: single boss encounter
+    if (levelIndex == 4)
+    {
+        enemies.push_back(getEnemyData(BOSS_ENEMY_ID));
+        return enemies;
+    }
+
+    int enemyCount = (levelIndex == 0) ? 2 : 3; // L1: 2 enemies, L2: 3 enemies
+    for (int i = 0; i < enemyCount; ++i) enemies.push_back(getRandomEnemyForLevel(levelIndex, rng));
+    return enemies;
+}
+
+void applyLevelTwoBoost(std::vector<Combatant> &party)
+{
+    const int hpBoost  = 30;
+    const int spBoost  = 15;
+    const int atkBoost = 10;
+    const int defBoost = 8;
+    for (Combatant &m : party)
+    {
+        m.maxHp += hpBoost;
+        m.currentHp = std::min(m.currentHp + hpBoost, m.maxHp);
+        m.maxSp += spBoost;
+        m.currentSp = std::min(m.currentSp + spBoost, m.maxSp);
+        m.baseAttack  += atkBoost;
+        m.baseDefense += defBoost;
+    }
+}
+
+void applyPersona(Combatant &joker, const Persona &persona)
+{
+    joker.baseAttack  = persona.baseAttack;
+    joker.baseDefense = persona.baseDefense;
+    joker.skills      = persona.skills;
+    joker.weaknesses  = persona.weaknesses;
+}
+
+std::vector<Combatant> makeStartingParty(int levelIndex)
+{
+    std::vector<Combatant> party = INITIAL_PARTY();
+    std::vector<Persona> personas = INITIAL_PERSONAS();
+    if (!party.empty() && !personas.empty()) applyPersona(party[0], personas[0]);
+    if (levelIndex >= 1) applyLevelTwoBoost(party);
+    return party;
+}
+
+void prepareParty(std::vector<Combatant> &party)
+{
+    for (Combatant &member : party)
+    {
+        member.currentAmmo = member.gunWeapon.magazineSize;
+        member.isGuarding  = false;
+        member.isDown      = false;
+        member.hasActed    = false;
+    }
+}
+
+bool canAfford(const Combatant &actor, const Ability &skill)
+{
+    return skill.isMagic ? actor.currentSp >= skill.cost : actor.currentHp > skill.cost;
+}
+
+bool isWeakTo(const Combatant &defender, Element element)
+{
+    if (defender.isGuarding) return false;
+    for (Element w : defender.weaknesses)
+        if (w == element) return true;
+    return false;
+}
+
+int computeDamage(const Combatant &attacker, const Combatant &defender, const Ability &skill, bool isWeakness)
+{
+    int attackPower = skill.damage;
+
+    // Melee and gun scale with the attacker's stats and weapon
+    if (skill.element == PHYS)     attackPower += attacker.getTotalAttack();
+    else if (skill.element == GUN) attackPower += attacker.getTotalGunAttack();
+
+    int damage = attackPower - defender.getTotalDefense();
+    if (damage < 1) damage = 1; // Minimum damage
+
+    if (isWeakness)          damage = (int)(damage * 1.5f);
+    if (defender.isGuarding) damage = (int)(damage * 0.5f);
+    return damage;
+}
+
+bool isHoldUp(const std::vector<Combatant> &enemies)
+{
+    bool allDown = true;
+    for (const Combatant &enemy : enemies)
+        if (enemy.isAlive && !enemy.isDown) allDown = false;
+    return anyAlive(enemies) && allDown;
+}
+
+int findNextActor(const std::vector<Combatant> &party)
+{
+    for (int i = 0; i < (int) party.size(); i++)
+        if (party[i].isAlive && !party[i].hasActed) return i;
+    return -1;
+}
+
+bool anyAlive(const std::vector<Combatant> &combatants)
+{
+    for (const Combatant &c : combatants)
+        if (c.isAlive) return true;
+    return false;
+}
+
+bool isPartyDefeated(const std::vector<Combatant> &party)
+{
+    return !party.empty() && !party[0].isAlive;
+}
+
+static CombatTurn makeTurn(CombatPhase phase, int slot)
+{
+    CombatTurn turn = { phase, slot };
+    return turn;
+}
+
+static int nextLivingEnemy(const std::vector<Combatant> &enemies, int after)
+{
+    for (int e = after + 1; e < (int) enemies.size(); e++)
+        if (enemies[e].isAlive) return e;
+    return -1;
+}
+
+// The next party member still to act this round, else the enemy phase
+static CombatTurn nextActorTurn(std::vector<Combatant> &party, std::vector<Combatant> &enemies)
+{
+    int next = findNextActor(party);
+    if (next >= 0)
+    {
+        party[next].isGuarding = false;
+        return makeTurn(PHASE_PARTY, next);
+    }
+
+    for (Combatant &enemy : enemies) enemy.isDown = false;
+    return makeTurn(PHASE_ENEMY, nextLivingEnemy(enemies, -1));
+}
+
+CombatTurn firstTurn(const std::vector<Combatant> &party, const std::vector<Combatant> &enemies, bool partyFirst)
+{
+    if (isPartyDefeated(party) || !anyAlive(enemies)) return makeTurn(PHASE_OVER, -1);
+    if (partyFirst) return makeTurn(PHASE_PARTY, findNextActor(party));
+    return makeTurn(PHASE_ENEMY, nextLivingEnemy(enemies, -1));
+}
+
+CombatTurn advanceTurn(std::vector<Combatant> &party, std::vector<Combatant> &enemies, CombatTurn turn,
+                       const CombatEvents &events)
+{
+    if (isPartyDefeated(party) || !anyAlive(enemies)) return makeTurn(PHASE_OVER, -1);
+
+    if (turn.phase == PHASE_ENEMY)
+    {
+        int next = nextLivingEnemy(enemies, turn.slot);
+        if (next >= 0) return makeTurn(PHASE_ENEMY, next);
+
+        // New round
+        for (Combatant &member : party) member.hasActed = false;
+        return nextActorTurn(party, enemies);
+    }
+
+    // Shots chain without a hold up check until the magazine is empty
+    if (events.contains(EVENT_RAPID_FIRE)) return makeTurn(PHASE_PARTY, turn.slot);
+    if (isHoldUp(enemies))                 return makeTurn(PHASE_HOLD_UP, turn.slot);
+    if (!party[turn.slot].hasActed)        return makeTurn(PHASE_PARTY, turn.slot); // 1 More
+    return nextActorTurn(party, enemies);
+}
@@ -0,0 +1,171 @@
+#include "GameTypes.h"
+#include "Random.h"
+#include <vector>
+
+#ifndef COMBAT_RULES_H
+#define COMBAT_RULES_H
+
+// The battle rules with no presentation attached: damage, weakness and
+// "1 More", hold up, the all-out attack, enemy attacks and turn order.
+//
+// An action is resolved in two steps. resolveAction() reads the combatants
+// and lists what happens as events, without changing anything;
+// applyEvents() then carries those events out. CombatScene presents the
+// same events as log lines, sounds and floating numbers, while
+// tools/combat_sim.cpp and CombatAI's lookahead resolve against copies.
+
+// Combatants are addressed by handle, never by name (enemies often share
+// one). Party slot i is handle i, enemy slot i is ENEMY_HANDLE_BASE + i;
+// slots do not move during a battle, so handles stay valid throughout.
+typedef int CombatantHandle;
+
+const CombatantHandle NO_COMBATANT      = -1;
+const CombatantHandle ENEMY_HANDLE_BASE = 64;
+
+inline CombatantHandle partyHandle(int slot) { return slot; }
+inline CombatantHandle enemyHandle(int slot) { return ENEMY_HANDLE_BASE + slot; }
+inline bool isEnemyHandle(CombatantHandle handle) { return handle >= ENEMY_HANDLE_BASE; }
+inline int  handleSlot(CombatantHandle handle) { return isEnemyHandle(handle) ? handle - ENEMY_HANDLE_BASE : handle; }
+
+Combatant       &getCombatant(std::vector<Combatant> &party, std::vector<Combatant> &enemies, CombatantHandle handle);
+const Combatant &getCombatant(const std::vector<Combatant> &party, const std::vector<Combatant> &enemies,
+                              CombatantHandle handle);
+
+enum CombatActionType
+{
+    ACTION_MELEE,
+    ACTION_GUN,
+    ACTION_SKILL,        // offensive or healing, by the skill's damage sign
+    ACTION_ITEM,
+    ACTION_GUARD,
+    ACTION_ALL_OUT,      // the hold up follow-through, on every living enemy
+    ACTION_ENEMY_ATTACK
+};
+
+struct CombatAction
+{
+    CombatActionType type;
+    CombatantHandle actor  = NO_COMBATANT;
+    CombatantHandle target = NO_COMBATANT;
+    int skill  = 0;           // ACTION_SKILL: index into the actor's skills
+    const Item *item = nullptr; // ACTION_ITEM; the caller removes it from the bag
+
+    CombatAction(CombatActionType type = ACTION_MELEE) : type {type} { }
+};
+
+enum CombatEventType
+{
+    EVENT_SPEND_SP,   // actor pays amount SP
+    EVENT_SPEND_HP,   // actor pays amount HP
+    EVENT_SHOT,       // actor fires one round
+    EVENT_DAMAGE,     // target loses amount HP
+    EVENT_KO,         // target falls
+    EVENT_DOWN,       // target knocked down by a weakness
+    EVENT_ONE_MORE,   // actor acts again
+    EVENT_RAPID_FIRE, // actor keeps the turn to shoot again; amount = rounds left
+    EVENT_STAND_UP,   // target's down state is cleared
+    EVENT_HEAL,       // target gains amount HP (capped at max)
+    EVENT_RESTORE_SP, // target gains amount SP (capped at max)
+    EVENT_REVIVE,     // target returns with amount HP
+    EVENT_NO_EFFECT,  // e.g. reviving the living
+    EVENT_GUARD,      // actor guards until their next turn
+    EVENT_TURN_END    // actor has acted
+};
+
+struct CombatEvent
+{
+    CombatEventType type;
+    CombatantHandle actor;
+    CombatantHandle target;
+    int  amount;
+    bool isWeakness; // EVENT_DAMAGE only
+};
+
+// What one action did, in order. Fixed capacity, so resolving never
+// allocates; the largest action (the all-out attack) needs two events per
+// enemy plus one.
+struct CombatEvents
+{
+    static const int CAPACITY = 32;
+
+    CombatEvent events[CAPACITY];
+    int count = 0;
+
+    void clear() { count = 0; }
+    void push(CombatEventType type, CombatantHandle actor, CombatantHandle target,
+              int amount = 0, bool isWeakness = false);
+    bool contains(CombatEventType type) const;
+
+    const CombatEvent &operator[](int i) const { return events[i]; }
+};
+
+// Lists what action does to the combatants, without changing them
+void resolveAction(const std::vector<Combatant> &party, const std::vector<Combatant> &enemies,
+                   const CombatAction &action, CombatEvents &events);
+
+// Carries out resolved events
+void applyEvents(std::vector<Combatant> &party, std::vector<Combatant> &enemies, const CombatEvents &events);
+
+// Enemy lineup for a battle started from the given level (scene index)
+std::vector<Combatant> rollEncounter(int levelIndex, RandomStream &rng);
+
+// The one-off stat boost the party gets on entering Level 2
+void applyLevelTwoBoost(std::vector<Combatant> &party);
+
+// Joker fights with his Persona's stats, skills and weaknesses
+void applyPersona(Combatant &joker, const Persona &persona);
+
+// The party as the game has it on reaching the given level (scene index):
+// Joker with his first Persona, plus the Level 2 boost from level 1 on
+std::vector<Combatant> makeStartingParty(int levelIndex);
+
+// Resets per-battle flags and reloads guns
+void prepareParty(std::vector<Combatant> &party);
+
+// Magic costs SP; physical skills cost HP and cannot take the user's last point
+bool canAfford(const Combatant &actor, const Ability &skill);
+
+// A guarding defender has no weaknesses
+bool isWeakTo(const Combatant &defender, Element element);
+int  computeDamage(const Combatant &attacker, const Combatant &defender, const Ability &skill, bool isWeakness);
+
+// Every living enemy is down
+bool isHoldUp(const std::vector<Combatant> &enemies);
+
+// First living party member who has not acted this round, or -1
+int findNextActor(const std::vector<Combatant> &party);
+
+bool anyAlive(const std::vector<Combatant> &combatants);
+
+// Joker (slot 0) falling ends the battle
+bool isPartyDefeated(const std::vector<Combatant> &party);
+
+// Turn order. CombatScene, tools/combat_sim.cpp and CombatAI's lookahead all
+// step battles with these, so they cannot disagree on who acts next.
+enum CombatPhase
+{
+    PHASE_PARTY,   // party member `slot` picks an action
+    PHASE_HOLD_UP, // every enemy is down: party member `slot` may launch the all-out attack
+    PHASE_ENEMY,   // enemy `slot` attacks
+    PHASE_OVER     // Joker has fallen or no enemy is left
+};
+
+struct CombatTurn
+{
+    CombatPhase phase;
+    int slot;
+};
+
+// The opening turn: the first party member's, or the first enemy's when the
+// party was caught
+CombatTurn firstTurn(const std::vector<Combatant> &party, const std::vector<Combatant> &enemies, bool partyFirst);
+
+// Who moves after `turn` took the action behind `events` (already applied).
+// Rapid fire and 1 More keep the actor, a hold up comes before anything else,
+// and the enemies act once every living party member has. Also does the
+// bookkeeping of starting the next turn: a new actor stops guarding, enemies
+// get up before their phase, and the party's acted flags reset after it.
+CombatTurn advanceTurn(std::vector<Combatant> &party, std::vector<Combatant> &enemies, CombatTurn turn,
+                       const CombatEvents &events);
+
+#endif // COMBAT_RULES_H
@@ -0,0 +1,309 @@
+#include "ContentDB.h"
+#include <stdio.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ContentDB gContentDB;
+
+bool ContentDB::load(const char *filePath)
+{
+    unload();
+
+#ifndef _WIN32
+    int fd = open(filePath, O_RDONLY);
+    if (fd < 0)
+    {
+        printf("ContentDB: no '%s' (build it with `make content`)\n", filePath);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size >= (off_t) sizeof(ContentHeader))
+    {
+        void *mapping = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED)
+        {
+            mData   = (const uint8_t *) mapping;
+            mSize   = (size_t) info.st_size;
+            mMapped = true;
+        }
+    }
+    close(fd);
+#else
+    // No mmap here: one read into a buffer, still used in place
+    FILE *file = fopen(filePath, "rb");
+    if (!file)
+    {
+        printf("ContentDB: no '%s' (build it with `make content`)\n", filePath);
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size >= (long) sizeof(ContentHeader))
+    {
+        uint8_t *buffer = new uint8_t[size];
+        if (fread(buffer, 1, (size_t) size, file) == (size_t) size)
+        {
+            mData = buffer;
+            mSize = (size_t) size;
+        }
+        else delete[] buffer;
+    }
+    fclose(file);
+#endif
+
+    if (!mData)
+    {
+        printf("ContentDB: cannot read '%s'\n", filePath);
+        return false;
+    }
+
+    mHeader = (const ContentHeader *) mData;
+    if (!validate())
+    {
+        printf("ContentDB: '%s' is damaged, incomplete or from another version\n", filePath);
+        unload();
+        return false;
+    }
+    return true;
+}
+
+void ContentDB::unload()
+{
+    if (mData)
+    {
+#ifndef _WIN32
+        if (mMapped) munmap((void *) mData, mSize);
+        else delete[] mData;
+#else
+        delete[] mData;
+#endif
+    }
+    mData   = nullptr;
+    mSize   = 0;
+    mMapped = false;
+    mHeader = nullptr;
+}
+
+// Every table, string and list must lie inside the file, and everything the
+// game looks up must be there, so lookups after load() need no checks
+bool ContentDB::validate() const
+{
+    if (mHeader->magic != CONTENT_MAGIC || mHeader->version != CONTENT_VERSION || mHeader->fileSize != mSize)
+        return false;
+
+    static const size_t RECORD_SIZES[CONTENT_TABLE_COUNT] = {
+        sizeof(SkillRecord), sizeof(ItemRecord), sizeof(EquipmentRecord), sizeof(PersonaRecord),
+        sizeof(MemberRecord), sizeof(EnemyRecord), sizeof(PoolRecord), sizeof(uint32_t), 1
+    };
+    for (int t = 0; t < CONTENT_TABLE_COUNT; t++)
+    {
+        const ContentTableRef &table = mHeader->tables[t];
+        if (table.offset % 4 != 0 || table.offset > mSize) return false;
+        if ((uint64_t) table.count * RECORD_SIZES[t] > mSize - table.offset) return false;
+    }
+
+    // The string table starts with "" and ends in a terminator
+    const char *strings = getTable<char>(TABLE_STRINGS);
+    uint32_t stringBytes = mHeader->tables[TABLE_STRINGS].count;
+    if (stringBytes == 0 || strings[0] != '\0' || strings[stringBytes - 1] != '\0') return false;
+
+    uint32_t valueCount = mHeader->tables[TABLE_VALUES].count;
+    auto stringOk = [&](ContentString s) { return s < stringBytes; };
+    auto listOk   = [&](ContentList l)   { return l.first <= valueCount && l.count <= valueCount - l.first; };
+    auto indexesOk = [&](ContentList l, int limit)
+    {
+        if (!listOk(l)) return false;
+        for (uint32_t i = 0; i < l.count; i++)
+            if (getValues(l)[i] >= (uint32_t) limit) return false;
+        return true;
+    };
+    auto equipmentOk = [&](int32_t index) { return index >= -1 && index < getEquipmentCount(); };
+    const int ELEMENT_COUNT = CURSE + 1;
+
+    for (int i = 0; i < getSkillCount(); i++)
+        if (!stringOk(getSkill(i).name) || getSkill(i).element >= ELEMENT_COUNT) return false;
+    for (int i = 0; i < getItemCount(); i++)
+        if (!stringOk(getItem(i).name) || !stringOk(getItem(i).description)) return false;
+    for (int i = 0; i < getEquipmentCount(); i++)
+    {
+        const EquipmentRecord &e = getEquipment(i);
+        if (!stringOk(e.name) || !stringOk(e.description) || e.type > EQUIP_ARMOR || e.element >= ELEMENT_COUNT) return false;
+    }
+    for (int i = 0; i < getPersonaCount(); i++)
+    {
+        const PersonaRecord &p = getPersona(i);
+        if (!stringOk(p.name) || !indexesOk(p.skills, getSkillCount()) || !indexesOk(p.weaknesses, ELEMENT_COUNT)) return false;
+    }
+    for (int i = 0; i < getMemberCount(); i++)
+    {
+        const MemberRecord &m = getMember(i);
+        if (!stringOk(m.name) || !stringOk(m.texturePath)) return false;
+        if (!equipmentOk(m.meleeWeapon) || !equipmentOk(m.gunWeapon) || !equipmentOk(m.armor)) return false;
+        if (!indexesOk(m.skills, getSkillCount()) || !indexesOk(m.weaknesses, ELEMENT_COUNT)) return false;
+    }
+    const EnemyRecord *enemies = getTable<EnemyRecord>(TABLE_ENEMIES);
+    for (int i = 0; i < getCount(TABLE_ENEMIES); i++)
+        if (!stringOk(enemies[i].name) || !indexesOk(enemies[i].weaknesses, ELEMENT_COUNT)) return false;
+
+    const PoolRecord *pools = getTable<PoolRecord>(TABLE_POOLS);
+    for (int i = 0; i < getCount(TABLE_POOLS); i++)
+    {
+        const PoolRecord &pool = pools[i];
+        if (!listOk(pool.entries) || pool.entries.count == 0) return false;
+        if (pool.kind == POOL_CHEST_EQUIPMENT || pool.kind == POOL_START_EQUIPMENT)
+        {
+            if (!indexesOk(pool.entries, getEquipmentCount())) return false;
+        }
+        else if (pool.kind == POOL_CHEST_ITEM || pool.kind == POOL_START_INVENTORY)
+        {
+            if (!indexesOk(pool.entries, getItemCount())) return false;
+        }
+        else if (pool.kind == POOL_ENCOUNTER)
+        {
+            for (uint32_t e = 0; e < pool.entries.count; e++)
+                if (!findEnemy((int) getValues(pool.entries)[e])) return false;
+        }
+        else return false;
+    }
+
+    // What the game needs: a party, a Persona to equip, both levels'
+    // encounters and loot, the boss and the starting bag
+    if (getMemberCount() == 0 || getPersonaCount() == 0 || !findEnemy(BOSS_ENEMY_ID)) return false;
+    for (int level = 0; level <= 1; level++)
+    {
+        const PoolRecord *encounters = findPool(POOL_ENCOUNTER, level);
+        if (!encounters || encounters->level != level) return false;
+        if (!findPool(POOL_CHEST_ITEM, level) || !findPool(POOL_CHEST_EQUIPMENT, level)) return false;
+    }
+    return findPool(POOL_START_INVENTORY, POOL_ANY_LEVEL) && findPool(POOL_START_EQUIPMENT, POOL_ANY_LEVEL);
+}
+
+const char *ContentDB::getString(ContentString string) const
+{
+    return getTable<char>(TABLE_STRINGS) + string;
+}
+
+const uint32_t *ContentDB::getValues(ContentList list) const
+{
+    return getTable<uint32_t>(TABLE_VALUES) + list.first;
+}
+
+const EnemyRecord *ContentDB::findEnemy(int id) const
+{
+    const EnemyRecord *enemies = getTable<EnemyRecord>(TABLE_ENEMIES);
+    for (int i = 0; i < getCount(TABLE_ENEMIES); i++)
+        if (enemies[i].id == id) return &enemies[i];
+    return nullptr;
+}
+
+const PoolRecord *ContentDB::findPool(ContentPoolKind kind, int level) const
+{
+    const PoolRecord *pools    = getTable<PoolRecord>(TABLE_POOLS);
+    const PoolRecord *fallback = nullptr;
+    for (int i = 0; i < getCount(TABLE_POOLS); i++)
+    {
+        if (pools[i].kind != (uint32_t) kind) continue;
+        if (pools[i].level == level) return &pools[i];
+        if (pools[i].level == POOL_ANY_LEVEL) fallback = &pools[i];
+    }
+    return fallback;
+}
+
+static std::vector<Element> makeElements(const ContentDB &db, ContentList list)
+{
+    const uint32_t *values = db.getValues(list);
+    std::vector<Element> elements;
+    elements.reserve(list.count);
+    for (uint32_t i = 0; i < list.count; i++) elements.push_back((Element) values[i]);
+    return elements;
+}
+
+static std::vector<Ability> makeSkills(const ContentDB &db, ContentList list)
+{
+    const uint32_t *values = db.getValues(list);
+    std::vector<Ability> skills;
+    skills.reserve(list.count);
+    for (uint32_t i = 0; i < list.count; i++)
+    {
+        const SkillRecord &record = db.getSkill((int) values[i]);
+        Ability skill = { db.getString(record.name), record.cost, record.damage, (Element) record.element, record.isMagic != 0 };
+        skills.push_back(skill);
+    }
+    return skills;
+}
+
+Item ContentDB::makeItem(int index) const
+{
+    const ItemRecord &record = getItem(index);
+    Item item = { getString(record.name), getString(record.description), record.value,
+                  record.isSP != 0, record.isRevive != 0, record.isBattle != 0 };
+    return item;
+}
+
+Equipment ContentDB::makeEquipment(int index) const
+{
+    // Value-initialised, so an empty slot has no type or stats
+    Equipment equipment{};
+    if (index < 0) return equipment;
+
+    const EquipmentRecord &record = getEquipment(index);
+    equipment.name         = getString(record.name);
+    equipment.type         = (EquipmentType) record.type;
+    equipment.attackPower  = record.attackPower;
+    equipment.defensePower = record.defensePower;
+    equipment.magazineSize = record.magazineSize;
+    equipment.element      = (Element) record.element;
+    equipment.description  = getString(record.description);
+    return equipment;
+}
+
+Persona ContentDB::makePersona(int index) const
+{
+    const PersonaRecord &record = getPersona(index);
+    Persona persona;
+    persona.name        = getString(record.name);
+    persona.baseAttack  = record.baseAttack;
+    persona.baseDefense = record.baseDefense;
+    persona.skills      = makeSkills(*this, record.skills);
+    persona.weaknesses  = makeElements(*this, record.weaknesses);
+    return persona;
+}
+
+Combatant ContentDB::makeMember(int index) const
+{
+    const MemberRecord &record = getMember(index);
+    Combatant member{};
+    member.id          = record.id;
+    member.name        = getString(record.name);
+    member.texturePath = getString(record.texturePath);
+    member.currentHp   = member.maxHp = record.maxHp;
+    member.currentSp   = member.maxSp = record.maxSp;
+    member.baseAttack  = record.baseAttack;
+    member.baseDefense = record.baseDefense;
+    member.meleeWeapon = makeEquipment(record.meleeWeapon);
+    member.gunWeapon   = makeEquipment(record.gunWeapon);
+    member.armor       = makeEquipment(record.armor);
+    member.currentAmmo = member.gunWeapon.magazineSize;
+    member.skills      = makeSkills(*this, record.skills);
+    member.weaknesses  = makeElements(*this, record.weaknesses);
+    return member;
+}
+
+Combatant ContentDB::makeEnemy(const EnemyRecord &record) const
+{
+    Combatant enemy{};
+    enemy.id          = record.id;
+    enemy.name        = getString(record.name);
+    enemy.currentHp   = enemy.maxHp = record.maxHp;
+    enemy.baseAttack  = record.baseAttack;
+    enemy.baseDefense = record.baseDefense;
+    enemy.weaknesses  = makeElements(*this, record.weaknesses);
+    enemy.isAlive     = true;
+    enemy.isDown      = false;
+    return enemy;
+}
@@ -0,0 +1,68 @@
+#include "ContentFormat.h"
+#include "GameTypes.h"
+#include <stddef.h>
+
+#ifndef CONTENT_DB_H
+#define CONTENT_DB_H
+
+// The compiled content blob (see ContentFormat.h), mapped into memory once
+// and read in place: records and strings point straight into the file.
+// lib/GameData.h builds game structs from it; the game, headless driver
+// and simulator refuse to start without it. Read-only after load(), so
+// any thread may use it.
+class ContentDB
+{
+private:
+    const uint8_t       *mData   = nullptr;
+    size_t               mSize   = 0;
+    bool                 mMapped = false; // else read into a buffer we own
+    const ContentHeader *mHeader = nullptr;
+
+    template <typename T>
+    const T *getTable(ContentTable table) const { return (const T *)(mData + mHeader->tables[table].offset); }
+    int getCount(ContentTable table) const      { return (int) mHeader->tables[table].count; }
+
+    bool validate() const;
+
+public:
+    ~ContentDB() { unload(); }
+
+    // Returns false if the file is missing, from another version,
+    // inconsistent, or lacks something the game needs
+    bool load(const char *filePath);
+    void unload();
+    bool isLoaded() const { return mHeader != nullptr; }
+
+    const char     *getString(ContentString string) const;
+    const uint32_t *getValues(ContentList list) const;
+
+    int getSkillCount() const     { return getCount(TABLE_SKILLS);    }
+    int getItemCount() const      { return getCount(TABLE_ITEMS);     }
+    int getEquipmentCount() const { return getCount(TABLE_EQUIPMENT); }
+    int getPersonaCount() const   { return getCount(TABLE_PERSONAS);  }
+    int getMemberCount() const    { return getCount(TABLE_MEMBERS);   }
+
+    const SkillRecord     &getSkill(int index) const     { return getTable<SkillRecord>(TABLE_SKILLS)[index];        }
+    const ItemRecord      &getItem(int index) const      { return getTable<ItemRecord>(TABLE_ITEMS)[index];          }
+    const EquipmentRecord &getEquipment(int index) const { return getTable<EquipmentRecord>(TABLE_EQUIPMENT)[index]; }
+    const PersonaRecord   &getPersona(int index) const   { return getTable<PersonaRecord>(TABLE_PERSONAS)[index];    }
+    const MemberRecord    &getMember(int index) const    { return getTable<MemberRecord>(TABLE_MEMBERS)[index];      }
+
+    const EnemyRecord *findEnemy(int id) const;
+    // The pool for this level, else the kind's POOL_ANY_LEVEL pool, else null
+    const PoolRecord  *findPool(ContentPoolKind kind, int level) const;
+
+    // Game structs for records
+    Item       makeItem(int index) const;
+    Equipment  makeEquipment(int index) const;
+    Persona    makePersona(int index) const;
+    Combatant  makeMember(int index) const;
+    Combatant  makeEnemy(const EnemyRecord &record) const;
+};
+
+// Where `make content` writes the blob, relative to the working directory
+const char *const CONTENT_BLOB_PATH = "assets/data/content.bin";
+
+extern ContentDB gContentDB;
+
+#endif // CONTENT_DB_H
@@ -0,0 +1,146 @@
+#include <stdint.h>
+
+#ifndef CONTENT_FORMAT_H
+#define CONTENT_FORMAT_H
+
+// Layout of assets/data/content.bin. tools/content_compiler.cpp writes it
+// from assets/data/content.txt and ContentDB reads it in place, so every
+// record here is plain data with a fixed size and 4-byte alignment.
+// Strings are offsets into one table of deduplicated, NUL-terminated
+// strings; lists are runs in one shared table of uint32 values. Stored
+// little-endian, like every platform the makefile builds for.
+
+const uint32_t CONTENT_MAGIC   = 0x44433550; // "P5CD"
+const uint32_t CONTENT_VERSION = 1;
+
+typedef uint32_t ContentString; // byte offset into TABLE_STRINGS; 0 is ""
+
+struct ContentList
+{
+    uint32_t first; // index into TABLE_VALUES
+    uint32_t count;
+};
+
+enum ContentTable
+{
+    TABLE_SKILLS,
+    TABLE_ITEMS,
+    TABLE_EQUIPMENT,
+    TABLE_PERSONAS,
+    TABLE_MEMBERS,  // the starting party, in order
+    TABLE_ENEMIES,
+    TABLE_POOLS,
+    TABLE_VALUES,   // uint32 list entries
+    TABLE_STRINGS,  // count is in bytes
+    CONTENT_TABLE_COUNT
+};
+
+struct ContentTableRef
+{
+    uint32_t offset; // from the start of the file
+    uint32_t count;
+};
+
+struct ContentHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fileSize;
+    ContentTableRef tables[CONTENT_TABLE_COUNT];
+};
+
+struct SkillRecord
+{
+    ContentString name;
+    int32_t cost;
+    int32_t damage;   // negative heals
+    uint8_t element;  // Element
+    uint8_t isMagic;
+    uint8_t pad[2];
+};
+
+struct ItemRecord
+{
+    ContentString name;
+    ContentString description;
+    int32_t value;
+    uint8_t isSP;
+    uint8_t isRevive;
+    uint8_t isBattle;
+    uint8_t pad;
+};
+
+struct EquipmentRecord
+{
+    ContentString name;
+    ContentString description;
+    int32_t attackPower;
+    int32_t defensePower;
+    int32_t magazineSize;
+    uint8_t type;     // EquipmentType
+    uint8_t element;  // Element
+    uint8_t pad[2];
+};
+
+struct PersonaRecord
+{
+    ContentString name;
+    int32_t baseAttack;
+    int32_t baseDefense;
+    ContentList skills;     // SkillRecord indices
+    ContentList weaknesses; // Element values
+};
+
+struct MemberRecord
+{
+    int32_t id;
+    ContentString name;
+    ContentString texturePath;
+    int32_t maxHp, maxSp;
+    int32_t baseAttack, baseDefense;
+    int32_t meleeWeapon, gunWeapon, armor; // EquipmentRecord index, or -1
+    ContentList skills;
+    ContentList weaknesses;
+};
+
+struct EnemyRecord
+{
+    int32_t id;
+    ContentString name;
+    int32_t maxHp;
+    int32_t baseAttack;
+    int32_t baseDefense;
+    ContentList weaknesses;
+};
+
+enum ContentPoolKind
+{
+    POOL_ENCOUNTER,       // enemy ids
+    POOL_CHEST_ITEM,      // ItemRecord indices
+    POOL_CHEST_EQUIPMENT, // EquipmentRecord indices
+    POOL_START_INVENTORY,
+    POOL_START_EQUIPMENT
+};
+
+const int32_t POOL_ANY_LEVEL = -1; // used for levels without a pool of their own
+
+const int32_t BOSS_ENEMY_ID = 99; // the final battle's enemy, which every blob must define
+
+struct PoolRecord
+{
+    uint32_t kind;  // ContentPoolKind
+    int32_t  level; // scene index, or POOL_ANY_LEVEL
+    ContentList entries;
+};
+
+// The compiler writes these structs byte for byte
+static_assert(sizeof(ContentHeader)   == 12 + 8 * CONTENT_TABLE_COUNT, "content header layout");
+static_assert(sizeof(SkillRecord)     == 16, "skill record layout");
+static_assert(sizeof(ItemRecord)      == 16, "item record layout");
+static_assert(sizeof(EquipmentRecord) == 24, "equipment record layout");
+static_assert(sizeof(PersonaRecord)   == 28, "persona record layout");
+static_assert(sizeof(MemberRecord)    == 56, "member record layout");
+static_assert(sizeof(EnemyRecord)     == 28, "enemy record layout");
+static_assert(sizeof(PoolRecord)      == 16, "pool record layout");
+
+#endif // CONTENT_FORMAT_H
@@ -1,136 +1,177 @@
 #include "Entity.h"
+#include "SpatialHash.h"
+#include "Profiler.h"
 #include "raymath.h" // Needed for Vector2Normalize, Vector2Length, Vector2Distance
 #include <cfloat> // For FLT_MAX
 #include <cmath> // For cosf
 
-Entity::Entity() : mPosition {0.0f, 0.0f}, mMovement {0.0f, 0.0f}, 
-                   mVelocity {0.0f, 0.0f}, mAcceleration {0.0f, 0.0f},
-                   mScale {DEFAULT_SIZE, DEFAULT_SIZE},
-                   mColliderDimensions {DEFAULT_SIZE, DEFAULT_SIZE}, 
-                   mTexture {}, mTextureType {SINGLE}, mAngle {0.0f},
-                   mSpriteSheetDimensions {}, mDirection {RIGHT}, 
-                   mAnimationAtlas {{}}, mAnimationIndices {}, mFrameSpeed {DEFAULT_FRAME_SPEED},
-                   mSpeed { DEFAULT_SPEED },
-                   mEntityType {NONE} { }
+Entity::Entity() : mSlot {gEntityStore.allocate()}
+{
+    gEntityStore.scales[mSlot]             = { DEFAULT_SIZE, DEFAULT_SIZE };
+    gEntityStore.colliderDimensions[mSlot] = { DEFAULT_SIZE, DEFAULT_SIZE };
+    gEntityStore.frameSpeeds[mSlot]        = DEFAULT_FRAME_SPEED;
+    gEntityStore.speeds[mSlot]             = DEFAULT_SPEED;
+}
 
 Entity::Entity(Vector2 position, Vector2 scale, const char *textureFilepath, 
-    EntityType entityType) : mPosition {position}, mVelocity {0.0f, 0.0f}, 
-    mAcceleration {0.0f, 0.0f}, mScale {scale}, mMovement {0.0f, 0.0f}, 
-    mColliderDimensions {scale}, mTexture {LoadTexture(textureFilepath)}, 
-    mTextureType {SINGLE}, mDirection {RIGHT}, mAnimationAtlas {{}}, 
-    mAnimationIndices {}, mFrameSpeed {0}, mSpeed {DEFAULT_SPEED}, 
-    mAngle {0.0f}, mEntityType {entityType} { }
+    EntityType entityType) : mSlot {gEntityStore.allocate()}
+{
+    gEntityStore.positions[mSlot]          = position;
+    gEntityStore.previousPositions[mSlot]  = position;
+    gEntityStore.scales[mSlot]             = scale;
+    gEntityStore.colliderDimensions[mSlot] = scale;
+    gEntityStore.textures[mSlot]           = gAssetCache.acquireTexture(textureFilepath);
+    gEntityStore.speeds[mSlot]             = DEFAULT_SPEED;
+    gEntityStore.types[mSlot]              = entityType;
+}
 
 Entity::Entity(Vector2 position, Vector2 scale, const char *textureFilepath, 
         TextureType textureType, Vector2 spriteSheetDimensions, std::map<Direction, 
         std::vector<int>> animationAtlas, EntityType entityType) : 
-        mPosition {position}, mVelocity {0.0f, 0.0f}, 
-        mAcceleration {0.0f, 0.0f}, mMovement { 0.0f, 0.0f }, mScale {scale},
-        mColliderDimensions {scale}, mTexture {LoadTexture(textureFilepath)}, 
-        mTextureType {ATLAS}, mSpriteSheetDimensions {spriteSheetDimensions},
-        mAnimationAtlas {animationAtlas}, mDirection {RIGHT},
-        mAnimationIndices {animationAtlas.at(RIGHT)}, 
-        mFrameSpeed {DEFAULT_FRAME_SPEED}, mAngle { 0.0f }, 
-        mSpeed { DEFAULT_SPEED }, mEntityType {entityType} { }
+        mSlot {gEntityStore.allocate()}
+{
+    gEntityStore.positions[mSlot]             = position;
+    gEntityStore.previousPositions[mSlot]     = position;
+    gEntityStore.scales[mSlot]                = scale;
+    gEntityStore.colliderDimensions[mSlot]    = scale;
+    gEntityStore.textures[mSlot]              = gAssetCache.acquireTexture(textureFilepath);
+    gEntityStore.textureTypes[mSlot]          = ATLAS;
+    gEntityStore.spriteSheetDimensions[mSlot] = spriteSheetDimensions;
+    gEntityStore.animationSets[mSlot]         = internAnimationSet(animationAtlas);
+    gEntityStore.frameSpeeds[mSlot]           = DEFAULT_FRAME_SPEED;
+    gEntityStore.speeds[mSlot]                = DEFAULT_SPEED;
+    gEntityStore.types[mSlot]                 = entityType;
+}
 
-Entity::~Entity() { UnloadTexture(mTexture); };
+Entity::~Entity()
+{
+    gAssetCache.releaseTexture(gEntityStore.textures[mSlot]);
+    gEntityStore.release(mSlot);
+}
 
 // COLLISION LOGIC
-void Entity::checkCollisionY(Entity *collidableEntities, int collisionCheckCount)
+void Entity::resolveCollisionY(Entity *collidableEntity)
 {
-    for (int i = 0; i < collisionCheckCount; i++)
+    if (!isColliding(collidableEntity)) return;
+
+    float yDistance = fabs(gEntityStore.positions[mSlot].y - gEntityStore.positions[collidableEntity->mSlot].y);
+    float yOverlap  = fabs(yDistance - (gEntityStore.colliderDimensions[mSlot].y / 2.0f) - 
+                      (gEntityStore.colliderDimensions[collidableEntity->mSlot].y / 2.0f));
+    
+    if (gEntityStore.velocities[mSlot].y > 0) // Moving Down (South)
     {
-        Entity *collidableEntity = &collidableEntities[i];
-        
-        if (isColliding(collidableEntity))
-        {
-            float yDistance = fabs(mPosition.y - collidableEntity->mPosition.y);
-            float yOverlap  = fabs(yDistance - (mColliderDimensions.y / 2.0f) - 
-                              (collidableEntity->mColliderDimensions.y / 2.0f));
-            
-            if (mVelocity.y > 0) // Moving Down (South)
-            {
-                mPosition.y -= yOverlap;
-                mVelocity.y  = 0;
-                mIsCollidingBottom = true; 
-            } 
-            else if (mVelocity.y < 0) // Moving Up (North)
-            {
-                mPosition.y += yOverlap;
-                mVelocity.y  = 0;
-                mIsCollidingTop = true;
-            }
-        }
+        gEntityStore.positions[mSlot].y -= yOverlap;
+        gEntityStore.velocities[mSlot].y  = 0;
+        gEntityStore.collidingBottom[mSlot] = true; 
+    } 
+    else if (gEntityStore.velocities[mSlot].y < 0) // Moving Up (North)
+    {
+        gEntityStore.positions[mSlot].y += yOverlap;
+        gEntityStore.velocities[mSlot].y  = 0;
+        gEntityStore.collidingTop[mSlot] = true;
     }
 }
 
-void Entity::checkCollisionX(Entity *collidableEntities, int collisionCheckCount)
+void Entity::resolveCollisionX(Entity *collidableEntity)
 {
-    for (int i = 0; i < collisionCheckCount; i++)
+    if (!isColliding(collidableEntity)) return;
+
+    float xDistance = fabs(gEntityStore.positions[mSlot].x - gEntityStore.positions[collidableEntity->mSlot].x);
+    float xOverlap  = fabs(xDistance - (gEntityStore.colliderDimensions[mSlot].x / 2.0f) - 
+                      (gEntityStore.colliderDimensions[collidableEntity->mSlot].x / 2.0f));
+
+    if (gEntityStore.velocities[mSlot].x > 0) // Moving Right
     {
-        Entity *collidableEntity = &collidableEntities[i];
-        
-        if (isColliding(collidableEntity))
-        {            
-            float xDistance = fabs(mPosition.x - collidableEntity->mPosition.x);
-            float xOverlap  = fabs(xDistance - (mColliderDimensions.x / 2.0f) - 
-                              (collidableEntity->mColliderDimensions.x / 2.0f));
-
-            if (mVelocity.x > 0) // Moving Right
-            {
-                mPosition.x     -= xOverlap;
-                mVelocity.x      = 0;
-                mIsCollidingRight = true;
-            } 
-            else if (mVelocity.x < 0) // Moving Left
-            {
-                mPosition.x    += xOverlap;
-                mVelocity.x     = 0;
-                mIsCollidingLeft = true;
-            }
-        }
+        gEntityStore.positions[mSlot].x     -= xOverlap;
+        gEntityStore.velocities[mSlot].x      = 0;
+        gEntityStore.collidingRight[mSlot] = true;
+    } 
+    else if (gEntityStore.velocities[mSlot].x < 0) // Moving Left
+    {
+        gEntityStore.positions[mSlot].x    += xOverlap;
+        gEntityStore.velocities[mSlot].x     = 0;
+        gEntityStore.collidingLeft[mSlot] = true;
     }
 }
 
+void Entity::checkCollisionY(Entity *collidableEntities, int collisionCheckCount)
+{
+    for (int i = 0; i < collisionCheckCount; i++)
+        resolveCollisionY(&collidableEntities[i]);
+}
+
+void Entity::checkCollisionX(Entity *collidableEntities, int collisionCheckCount)
+{
+    for (int i = 0; i < collisionCheckCount; i++)
+        resolveCollisionX(&collidableEntities[i]);
+}
+
+// Scratch list for grid queries; the game updates entities on one thread
+static std::vector<Entity*> gNearbyEntities;
+
+void Entity::checkCollisionY(const SpatialHash *collidables)
+{
+    if (collidables == nullptr) return;
+
+    gNearbyEntities.clear();
+    collidables->query({ gEntityStore.positions[mSlot].x - gEntityStore.colliderDimensions[mSlot].x / 2.0f,
+                         gEntityStore.positions[mSlot].y - gEntityStore.colliderDimensions[mSlot].y / 2.0f,
+                         gEntityStore.colliderDimensions[mSlot].x, gEntityStore.colliderDimensions[mSlot].y }, gNearbyEntities);
+
+    for (Entity *collidableEntity : gNearbyEntities) resolveCollisionY(collidableEntity);
+}
+
+void Entity::checkCollisionX(const SpatialHash *collidables)
+{
+    if (collidables == nullptr) return;
+
+    gNearbyEntities.clear();
+    collidables->query({ gEntityStore.positions[mSlot].x - gEntityStore.colliderDimensions[mSlot].x / 2.0f,
+                         gEntityStore.positions[mSlot].y - gEntityStore.colliderDimensions[mSlot].y / 2.0f,
+                         gEntityStore.colliderDimensions[mSlot].x, gEntityStore.colliderDimensions[mSlot].y }, gNearbyEntities);
+
+    for (Entity *collidableEntity : gNearbyEntities) resolveCollisionX(collidableEntity);
+}
+
 void Entity::checkCollisionY(Map *map)
 {
     if (map == nullptr) return;
 
     const float epsilon = 0.001f;
-    float halfWidth = mColliderDimensions.x / 2.0f;
-    float halfHeight = mColliderDimensions.y / 2.0f;
+    float halfWidth = gEntityStore.colliderDimensions[mSlot].x / 2.0f;
+    float halfHeight = gEntityStore.colliderDimensions[mSlot].y / 2.0f;
 
-    Vector2 topCentreProbe    = { mPosition.x, mPosition.y - halfHeight };
-    Vector2 topLeftProbe      = { mPosition.x - halfWidth, mPosition.y - halfHeight };
-    Vector2 topRightProbe     = { mPosition.x + (halfWidth - epsilon), mPosition.y - halfHeight };
+    Vector2 topCentreProbe    = { gEntityStore.positions[mSlot].x, gEntityStore.positions[mSlot].y - halfHeight };
+    Vector2 topLeftProbe      = { gEntityStore.positions[mSlot].x - halfWidth, gEntityStore.positions[mSlot].y - halfHeight };
+    Vector2 topRightProbe     = { gEntityStore.positions[mSlot].x + (halfWidth - epsilon), gEntityStore.positions[mSlot].y - halfHeight };
 
-    Vector2 bottomCentreProbe = { mPosition.x, mPosition.y + halfHeight };
-    Vector2 bottomLeftProbe   = { mPosition.x - halfWidth, mPosition.y + halfHeight };
-    Vector2 bottomRightProbe  = { mPosition.x + (halfWidth - epsilon), mPosition.y + halfHeight };
+    Vector2 bottomCentreProbe = { gEntityStore.positions[mSlot].x, gEntityStore.positions[mSlot].y + halfHeight };
+    Vector2 bottomLeftProbe   = { gEntityStore.positions[mSlot].x - halfWidth, gEntityStore.positions[mSlot].y + halfHeight };
+    Vector2 bottomRightProbe  = { gEntityStore.positions[mSlot].x + (halfWidth - epsilon), gEntityStore.positions[mSlot].y + halfHeight };
 
     float xOverlap = 0.0f;
     float yOverlap = 0.0f;
 
     // COLLISION NORTH (Moving Up)
-    if (mVelocity.y < 0.0f &&
+    if (gEntityStore.velocities[mSlot].y < 0.0f &&
         (map->isSolidTileAt(topCentreProbe, &xOverlap, &yOverlap) ||
          map->isSolidTileAt(topLeftProbe, &xOverlap, &yOverlap)   ||
          map->isSolidTileAt(topRightProbe, &xOverlap, &yOverlap)))
     {
-        mPosition.y += yOverlap; 
-        mVelocity.y  = 0.0f;
-        mIsCollidingTop = true;
+        gEntityStore.positions[mSlot].y += yOverlap; 
+        gEntityStore.velocities[mSlot].y  = 0.0f;
+        gEntityStore.collidingTop[mSlot] = true;
     }
 
     // COLLISION SOUTH (Moving Down)
-    if (mVelocity.y > 0.0f && 
+    if (gEntityStore.velocities[mSlot].y > 0.0f && 
         (map->isSolidTileAt(bottomCentreProbe, &xOverlap, &yOverlap) ||
          map->isSolidTileAt(bottomLeftProbe, &xOverlap, &yOverlap)   ||
          map->isSolidTileAt(bottomRightProbe, &xOverlap, &yOverlap)))
     {
-        mPosition.y -= yOverlap; 
-        mVelocity.y  = 0.0f;
-        mIsCollidingBottom = true;
+        gEntityStore.positions[mSlot].y -= yOverlap; 
+        gEntityStore.velocities[mSlot].y  = 0.0f;
+        gEntityStore.collidingBottom[mSlot] = true;
     } 
 }
 
@@ -139,40 +180,40 @@ void Entity::checkCollisionX(Map *map)
     if (map == nullptr) return;
 
     const float epsilon = 0.001f;
-    float halfWidth = mColliderDimensions.x / 2.0f;
-    float halfHeight = mColliderDimensions.y / 2.0f;
+    float halfWidth = gEntityStore.colliderDimensions[mSlot].x / 2.0f;
+    float halfHeight = gEntityStore.colliderDimensions[mSlot].y / 2.0f;
 
-    Vector2 leftCentreProbe  = { mPosition.x - halfWidth, mPosition.y };
-    Vector2 leftTopProbe     = { mPosition.x - halfWidth, mPosition.y - halfHeight };
-    Vector2 leftBottomProbe  = { mPosition.x - halfWidth, mPosition.y + (halfHeight - epsilon) };
+    Vector2 leftCentreProbe  = { gEntityStore.positions[mSlot].x - halfWidth, gEntityStore.positions[mSlot].y };
+    Vector2 leftTopProbe     = { gEntityStore.positions[mSlot].x - halfWidth, gEntityStore.positions[mSlot].y - halfHeight };
+    Vector2 leftBottomProbe  = { gEntityStore.positions[mSlot].x - halfWidth, gEntityStore.positions[mSlot].y + (halfHeight - epsilon) };
 
-    Vector2 rightCentreProbe = { mPosition.x + halfWidth, mPosition.y };
-    Vector2 rightTopProbe    = { mPosition.x + halfWidth, mPosition.y - halfHeight };
-    Vector2 rightBottomProbe = { mPosition.x + halfWidth, mPosition.y + (halfHeight - epsilon) };
+    Vector2 rightCentreProbe = { gEntityStore.positions[mSlot].x + halfWidth, gEntityStore.positions[mSlot].y };
+    Vector2 rightTopProbe    = { gEntityStore.positions[mSlot].x + halfWidth, gEntityStore.positions[mSlot].y - halfHeight };
+    Vector2 rightBottomProbe = { gEntityStore.positions[mSlot].x + halfWidth, gEntityStore.positions[mSlot].y + (halfHeight - epsilon) };
 
     float xOverlap = 0.0f;
     float yOverlap = 0.0f;
 
     // COLLISION WEST (Moving Left)
-    if (mVelocity.x < 0.0f &&
+    if (gEntityStore.velocities[mSlot].x < 0.0f &&
         (map->isSolidTileAt(leftCentreProbe, &xOverlap, &yOverlap) ||
          map->isSolidTileAt(leftTopProbe, &xOverlap, &yOverlap)   ||
          map->isSolidTileAt(leftBottomProbe, &xOverlap, &yOverlap)))
     {
-        mPosition.x += xOverlap; 
-        mVelocity.x  = 0.0f;
-        mIsCollidingLeft = true;
+        gEntityStore.positions[mSlot].x += xOverlap; 
+        gEntityStore.velocities[mSlot].x  = 0.0f;
+        gEntityStore.collidingLeft[mSlot] = true;
     }
 
     // COLLISION EAST (Moving Right)
-    if (mVelocity.x > 0.0f && 
+    if (gEntityStore.velocities[mSlot].x > 0.0f && 
         (map->isSolidTileAt(rightCentreProbe, &xOverlap, &yOverlap) ||
          map->isSolidTileAt(rightTopProbe, &xOverlap, &yOverlap)   ||
          map->isSolidTileAt(rightBottomProbe, &xOverlap, &yOverlap)))
     {
-        mPosition.x -= xOverlap; 
-        mVelocity.x  = 0.0f;
-        mIsCollidingRight = true;
+        gEntityStore.positions[mSlot].x -= xOverlap; 
+        gEntityStore.velocities[mSlot].x  = 0.0f;
+        gEntityStore.collidingRight[mSlot] = true;
     } 
 }
 
@@ -180,10 +221,10 @@ bool Entity::isColliding(Entity *other) const
 {
     if (!other->isActive() || other == this) return false;
 
-    float xDistance = fabs(mPosition.x - other->getPosition().x) - 
-        ((mColliderDimensions.x + other->getColliderDimensions().x) / 2.0f);
-    float yDistance = fabs(mPosition.y - other->getPosition().y) - 
-        ((mColliderDimensions.y + other->getColliderDimensions().y) / 2.0f);
+    float xDistance = fabs(gEntityStore.positions[mSlot].x - other->getPosition().x) - 
+        ((gEntityStore.colliderDimensions[mSlot].x + other->getColliderDimensions().x) / 2.0f);
+    float yDistance = fabs(gEntityStore.positions[mSlot].y - other->getPosition().y) - 
+        ((gEntityStore.colliderDimensions[mSlot].y + other->getColliderDimensions().y) / 2.0f);
 
     if (xDistance < 0.0f && yDistance < 0.0f) return true;
 
@@ -194,22 +235,19 @@ bool Entity::isColliding(Entity *other) const
 
 void Entity::animate(float deltaTime)
 {
-    auto it = mAnimationAtlas.find(mDirection);
-    if (it != mAnimationAtlas.end()) {
-        mAnimationIndices = it->second;
-    } else if (!mAnimationAtlas.empty()) {
-        auto rt = mAnimationAtlas.find(RIGHT);
-        mAnimationIndices = (rt != mAnimationAtlas.end()) ? rt->second : mAnimationAtlas.begin()->second;
-    }
+    const AnimationSet *animationSet = gEntityStore.animationSets[mSlot];
+    if (animationSet == nullptr) return;
 
-    mAnimationTime += deltaTime;
-    float framesPerSecond = 1.0f / mFrameSpeed;
+    const AnimationClip &clip = animationSet->getClip(gEntityStore.directions[mSlot]);
+    if (clip.frameCount == 0) return;
 
-    if (mAnimationTime >= framesPerSecond)
+    gEntityStore.animationTimes[mSlot] += deltaTime;
+    float framesPerSecond = 1.0f / gEntityStore.frameSpeeds[mSlot];
+
+    if (gEntityStore.animationTimes[mSlot] >= framesPerSecond)
     {
-        mAnimationTime = 0.0f;
-        mCurrentFrameIndex++;
-        mCurrentFrameIndex %= mAnimationIndices.size();
+        gEntityStore.animationTimes[mSlot] = 0.0f;
+        gEntityStore.frameIndices[mSlot] = (gEntityStore.frameIndices[mSlot] + 1) % clip.frameCount;
     }
 }
 
@@ -217,7 +255,7 @@ void Entity::animate(float deltaTime)
 // Central AI Execution
 void Entity::aiExecute(Entity* player, Map* map, float deltaTime)
 {
-    switch (mAIType)
+    switch (gEntityStore.aiTypes[mSlot])
     {
     case AI_GUARD:
         aiGuard(player, map, deltaTime);
@@ -225,34 +263,34 @@ void Entity::aiExecute(Entity* player, Map* map, float deltaTime)
 
     case AI_SENTRY:
         // Wake if player close
-        if (Vector2Distance(mPosition, player->getPosition()) < 150.0f) {
-            mAIState = CHASING;
-            mSpeed = 90; // ensure sentries move when chasing
+        if (Vector2Distance(gEntityStore.positions[mSlot], player->getPosition()) < 150.0f) {
+            gEntityStore.aiStates[mSlot] = CHASING;
+            gEntityStore.speeds[mSlot] = 90; // ensure sentries move when chasing
         }
-        if (mAIState == CHASING) {
-            mSpeed = std::max(mSpeed, 80); // keep a minimum chase speed
-            aiChase(player, deltaTime);
+        if (gEntityStore.aiStates[mSlot] == CHASING) {
+            gEntityStore.speeds[mSlot] = std::max(gEntityStore.speeds[mSlot], 80); // keep a minimum chase speed
+            aiChase(player, map, deltaTime);
             // After 5 seconds of chasing, return to original position
-            mWaitTimer += deltaTime;
-            if (mWaitTimer >= 5.0f) {
-                mAIState = RETURNING;
-                mWaitTimer = 0.0f;
-                mSpeed = 70; // slower speed when returning
+            gEntityStore.waitTimers[mSlot] += deltaTime;
+            if (gEntityStore.waitTimers[mSlot] >= 5.0f) {
+                gEntityStore.aiStates[mSlot] = RETURNING;
+                gEntityStore.waitTimers[mSlot] = 0.0f;
+                gEntityStore.speeds[mSlot] = 70; // slower speed when returning
             }
         }
-        else if (mAIState == RETURNING) {
-            moveTowards(mStartPosition, deltaTime);
+        else if (gEntityStore.aiStates[mSlot] == RETURNING) {
+            followPath(map, gEntityStore.startPositions[mSlot], deltaTime);
             // Face toward start
-            Vector2 dir = Vector2Subtract(mStartPosition, mPosition);
+            Vector2 dir = Vector2Subtract(gEntityStore.startPositions[mSlot], gEntityStore.positions[mSlot]);
             if (fabs(dir.x) > fabs(dir.y)) {
-                mDirection = (dir.x > 0) ? RIGHT : LEFT;
+                gEntityStore.directions[mSlot] = (dir.x > 0) ? RIGHT : LEFT;
             } else {
-                mDirection = (dir.y > 0) ? DOWN : UP;
+                gEntityStore.directions[mSlot] = (dir.y > 0) ? DOWN : UP;
             }
-            if (Vector2Distance(mPosition, mStartPosition) < 5.0f) {
-                mAIState = IDLE;
-                mSpeed = 0; // sentries idle when at post
-                mMovement = {0.0f, 0.0f};
+            if (Vector2Distance(gEntityStore.positions[mSlot], gEntityStore.startPositions[mSlot]) < 5.0f) {
+                gEntityStore.aiStates[mSlot] = IDLE;
+                gEntityStore.speeds[mSlot] = 0; // sentries idle when at post
+                gEntityStore.movements[mSlot] = {0.0f, 0.0f};
             }
         }
         break;
@@ -260,23 +298,24 @@ void Entity::aiExecute(Entity* player, Map* map, float deltaTime)
     case AI_BOSS:
         // Boss remains idle (no chase), but can face player
         if (player) {
-            Vector2 dir = Vector2Subtract(player->getPosition(), mPosition);
+            Vector2 dir = Vector2Subtract(player->getPosition(), gEntityStore.positions[mSlot]);
             if (fabs(dir.x) > fabs(dir.y)) {
-                mDirection = (dir.x > 0) ? RIGHT : LEFT;
+                gEntityStore.directions[mSlot] = (dir.x > 0) ? RIGHT : LEFT;
             } else {
-                mDirection = (dir.y > 0) ? DOWN : UP;
+                gEntityStore.directions[mSlot] = (dir.y > 0) ? DOWN : UP;
             }
         }
-        mMovement = {0.0f, 0.0f};
-        mSpeed = 0.0f; // no movement
+        gEntityStore.movements[mSlot] = {0.0f, 0.0f};
+        gEntityStore.speeds[mSlot] = 0.0f; // no movement
         break;
 
     case AI_SEARCHLIGHT:
         // Patrol behavior, longer/narrower vision cone to trigger alarm
         aiPatrol(deltaTime);
-        if (player && isEntityInSight(player, 150.0f, 45.0f)) {
+        if (player && (gEntityStore.hasPerception[mSlot] ?
+                gEntityStore.perceivesPlayer[mSlot] != 0 : sensePlayer(player, map))) {
             player->setAlarmTimer(6.0f);
-            mAIState = AI_AWAKENED;
+            gEntityStore.aiStates[mSlot] = AI_AWAKENED;
         }
         break;
     default:
@@ -288,38 +327,38 @@ void Entity::aiExecute(Entity* player, Map* map, float deltaTime)
 void Entity::aiPatrol(float deltaTime)
 {
     // Simple logic: Move to Target, then wait, then flip back to Start
-    if (mAIState == IDLE) {
-        mWaitTimer += deltaTime;
-        if (mWaitTimer > 2.0f) {
-            mAIState = PATROLLING;
-            mWaitTimer = 0.0f;
+    if (gEntityStore.aiStates[mSlot] == IDLE) {
+        gEntityStore.waitTimers[mSlot] += deltaTime;
+        if (gEntityStore.waitTimers[mSlot] > 2.0f) {
+            gEntityStore.aiStates[mSlot] = PATROLLING;
+            gEntityStore.waitTimers[mSlot] = 0.0f;
         }
-        mMovement = {0.0f, 0.0f};
+        gEntityStore.movements[mSlot] = {0.0f, 0.0f};
         return;
     }
-    else if (mAIState == PATROLLING) {
-        moveTowards(mPatrolTarget, deltaTime);
-        if (Vector2Distance(mPosition, mPatrolTarget) < 5.0f) {
+    else if (gEntityStore.aiStates[mSlot] == PATROLLING) {
+        moveTowards(gEntityStore.patrolTargets[mSlot], deltaTime);
+        if (Vector2Distance(gEntityStore.positions[mSlot], gEntityStore.patrolTargets[mSlot]) < 5.0f) {
             // Swap Target and Start to loop
-            Vector2 temp = mStartPosition;
-            mStartPosition = mPatrolTarget;
-            mPatrolTarget = temp;
-            mAIState = IDLE;
-            mMovement = {0.0f, 0.0f};
+            Vector2 temp = gEntityStore.startPositions[mSlot];
+            gEntityStore.startPositions[mSlot] = gEntityStore.patrolTargets[mSlot];
+            gEntityStore.patrolTargets[mSlot] = temp;
+            gEntityStore.aiStates[mSlot] = IDLE;
+            gEntityStore.movements[mSlot] = {0.0f, 0.0f};
             // flip direction. left to right or up to down
-            switch (mDirection)
+            switch (gEntityStore.directions[mSlot])
             {
             case LEFT:
-                mDirection = RIGHT;
+                gEntityStore.directions[mSlot] = RIGHT;
                 break;
             case RIGHT:
-                mDirection = LEFT;
+                gEntityStore.directions[mSlot] = LEFT;
                 break;
             case UP:
-                mDirection = DOWN;
+                gEntityStore.directions[mSlot] = DOWN;
                 break;
             case DOWN:
-                mDirection = UP;
+                gEntityStore.directions[mSlot] = UP;
                 break;
             default:
                 break;
@@ -329,70 +368,74 @@ void Entity::aiPatrol(float deltaTime)
     }
 }
 
-// Chase logic: move directly toward player until far; then transition to RETURNING.
-void Entity::aiChase(Entity* player, float deltaTime)
+// Chase logic: head straight for the player when nothing is in the way,
+// otherwise follow the map's shared flow field around the walls.
+void Entity::aiChase(Entity* player, Map* map, float deltaTime)
 {
     if (!player) return;
-    moveTowards(player->getPosition(), deltaTime);
-    // Face the target explicitly
-    Vector2 dir = Vector2Subtract(player->getPosition(), mPosition);
+    Vector2 position = gEntityStore.positions[mSlot];
+    Vector2 target   = player->getPosition();
+
+    Vector2 dir = { 0.0f, 0.0f };
+    if (map != nullptr && !map->hasLineOfSight(position, target))
+        dir = map->getFlowDirection(position, target);
+
+    if (Vector2Length(dir) > 0.0f) {
+        gEntityStore.movements[mSlot] = dir;
+    } else {
+        moveTowards(target, deltaTime);
+        dir = Vector2Subtract(target, position);
+    }
+
+    // Face the way we are heading
     if (fabs(dir.x) > fabs(dir.y)) {
-        mDirection = (dir.x > 0) ? RIGHT : LEFT;
+        gEntityStore.directions[mSlot] = (dir.x > 0) ? RIGHT : LEFT;
     } else {
-        mDirection = (dir.y > 0) ? DOWN : UP;
+        gEntityStore.directions[mSlot] = (dir.y > 0) ? DOWN : UP;
     }
 }
 
 // Guard composite: handle patrol/chase/return transitions and detection.
 void Entity::aiGuard(Entity* player, Map* map, float deltaTime)
 {
-    //  Preliminary Cone Check (Distance & Angle)
-    bool canSeePlayer = player ? isEntityInSight(player, 100.0f, 90.0f) : false;
-
-    //  Raycast Check
-    // If the simple cone check passes, we must verify NO WALLS exist between them.
-    if (canSeePlayer && map != nullptr)
-    {
-        if (!map->hasLineOfSight(mPosition, player->getPosition()))
-        {
-            canSeePlayer = false; // Blocked by wall -> Player is safe
-        }
-    }
+    // Use the scheduler's cached perception; sense directly without one
+    bool canSeePlayer = gEntityStore.hasPerception[mSlot] ?
+        gEntityStore.perceivesPlayer[mSlot] != 0 : sensePlayer(player, map);
 
-    switch (mAIState)
+    switch (gEntityStore.aiStates[mSlot])
     {
     case IDLE:
     case PATROLLING:
         if (canSeePlayer) {
-            mAIState = CHASING;
-            mSpeed = 100; // accelerate when chasing
+            gEntityStore.aiStates[mSlot] = CHASING;
+            gEntityStore.speeds[mSlot] = 100; // accelerate when chasing
         }
         aiPatrol(deltaTime); // continue patrolling until chase triggers
         break;
 
     case CHASING:
         if (!canSeePlayer) {
-            mWaitTimer += deltaTime;
-            if (mWaitTimer > 2.0f) {
-                mAIState = RETURNING;
-                mWaitTimer = 0.0f;
-                mSpeed = 70; // slow back down
+            gEntityStore.waitTimers[mSlot] += deltaTime;
+            if (gEntityStore.waitTimers[mSlot] > 2.0f) {
+                gEntityStore.aiStates[mSlot] = RETURNING;
+                gEntityStore.waitTimers[mSlot] = 0.0f;
+                gEntityStore.speeds[mSlot] = 70; // slow back down
             }
         } else {
-            mWaitTimer = 0.0f;
+            gEntityStore.waitTimers[mSlot] = 0.0f;
         }
-        aiChase(player, deltaTime);
+        aiChase(player, map, deltaTime);
         break;
 
     case RETURNING:
-        moveTowards(mStartPosition, deltaTime);
-        if (Vector2Distance(mPosition, mStartPosition) < 5.0f) {
-            mAIState = IDLE;
-            mSpeed = 80; // ensure base speed
+        followPath(map, gEntityStore.startPositions[mSlot], deltaTime);
+        if (Vector2Distance(gEntityStore.positions[mSlot], gEntityStore.startPositions[mSlot]) < 5.0f) {
+            gEntityStore.aiStates[mSlot] = IDLE;
+            gEntityStore.speeds[mSlot] = 80; // ensure base speed
         }
         if (canSeePlayer) {
-            mAIState = CHASING;
-            mSpeed = 140;
+            gEntityStore.aiStates[mSlot] = CHASING;
+            gEntityStore.speeds[mSlot] = 140;
         }
         break;
     }
@@ -401,85 +444,142 @@ void Entity::aiGuard(Entity* player, Map* map, float deltaTime)
 void Entity::moveTowards(Vector2 target, float deltaTime)
 {
     (void)deltaTime; 
-    Vector2 directionRaw = Vector2Subtract(target, mPosition);
+    Vector2 directionRaw = Vector2Subtract(target, gEntityStore.positions[mSlot]);
     if (Vector2Length(directionRaw) > 0.0f)
-        mMovement = Vector2Normalize(directionRaw);
+        gEntityStore.movements[mSlot] = Vector2Normalize(directionRaw);
     else
-        mMovement = {0.0f, 0.0f};
+        gEntityStore.movements[mSlot] = {0.0f, 0.0f};
 }
 
 
+void Entity::followPath(Map* map, Vector2 target, float deltaTime)
+{
+    if (map == nullptr) { moveTowards(target, deltaTime); return; }
+
+    std::vector<Vector2> &path = gEntityStore.paths[mSlot];
+    int &cursor                = gEntityStore.pathCursors[mSlot];
+    Vector2 position           = gEntityStore.positions[mSlot];
+    float tileSize             = map->getTileSize();
+
+    // Replan when the goal moved, the map changed, we were knocked off the
+    // route (e.g. by a collision), or an old finished route is being reused
+    // from somewhere else. A failed plan is kept as an empty route so it is
+    // not retried every frame.
+    bool isOffRoute = cursor < (int)path.size() ?
+        Vector2Distance(position, path[cursor]) > tileSize * 2.0f :
+        !path.empty() && Vector2Distance(position, target) > tileSize * 2.0f;
+    bool isStale = isOffRoute ||
+        gEntityStore.pathVersions[mSlot] != map->getNavVersion() ||
+        Vector2Distance(gEntityStore.pathGoals[mSlot], target) > tileSize / 2.0f;
+    if (isStale)
+    {
+        map->findPath(position, target, path);
+        cursor = 0;
+        gEntityStore.pathGoals[mSlot]    = target;
+        gEntityStore.pathVersions[mSlot] = map->getNavVersion();
+    }
+
+    // Advance past waypoints we have reached
+    while (cursor < (int)path.size() && Vector2Distance(position, path[cursor]) < tileSize * 0.25f)
+        cursor++;
+
+    moveTowards(cursor < (int)path.size() ? path[cursor] : target, deltaTime);
+}
+
 void Entity::update(float deltaTime, Entity *player, Map *map, 
     Entity *collidableEntities, int collisionCheckCount)
+{
+    updateMotion(deltaTime, player, map, collidableEntities, collisionCheckCount, nullptr);
+}
+
+void Entity::update(float deltaTime, Entity *player, Map *map,
+    const SpatialHash *collidables)
+{
+    updateMotion(deltaTime, player, map, nullptr, 0, collidables);
+}
+
+void Entity::updateMotion(float deltaTime, Entity *player, Map *map,
+    Entity *collidableEntities, int collisionCheckCount,
+    const SpatialHash *collidables)
 {
     if (isActive()) {
         // Tick down alarm timer (used on Player)
-        if (mAlarmTimer > 0.0f) {
-            mAlarmTimer -= deltaTime;
-            if (mAlarmTimer < 0.0f) mAlarmTimer = 0.0f;
+        if (gEntityStore.alarmTimers[mSlot] > 0.0f) {
+            gEntityStore.alarmTimers[mSlot] -= deltaTime;
+            if (gEntityStore.alarmTimers[mSlot] < 0.0f) gEntityStore.alarmTimers[mSlot] = 0.0f;
         }
         // Phase 3: central AI hook
-        if (mEntityType == NPC) {
+        if (gEntityStore.types[mSlot] == NPC) {
             aiExecute(player, map, deltaTime);
         }
 
     resetColliderFlags();
 
     // NORMALIZE MOVEMENT (Prevent fast diagonal movement)
-    if (Vector2Length(mMovement) > 0) {
-        mMovement = Vector2Normalize(mMovement);
+    if (Vector2Length(gEntityStore.movements[mSlot]) > 0) {
+        gEntityStore.movements[mSlot] = Vector2Normalize(gEntityStore.movements[mSlot]);
     }
 
     // UPDATE VELOCITY (No Gravity)
     // We can still add Acceleration here if we want "slippery" movement,
     // otherwise, we just set velocity directly from movement * speed.
-    mVelocity.x = mMovement.x * mSpeed;
-    mVelocity.y = mMovement.y * mSpeed;
+    gEntityStore.velocities[mSlot].x = gEntityStore.movements[mSlot].x * gEntityStore.speeds[mSlot];
+    gEntityStore.velocities[mSlot].y = gEntityStore.movements[mSlot].y * gEntityStore.speeds[mSlot];
 
-    // APPLY X MOVEMENT & COLLISION
-    mPosition.x += mVelocity.x * deltaTime;
-    checkCollisionX(collidableEntities, collisionCheckCount);
-    checkCollisionX(map);
-
-    // APPLY Y MOVEMENT & COLLISION
-    mPosition.y += mVelocity.y * deltaTime;
-    checkCollisionY(collidableEntities, collisionCheckCount);
-    checkCollisionY(map);
+    {
+        PROFILE_SCOPE(PROFILE_COLLISION);
+
+        // APPLY X MOVEMENT & COLLISION
+        gEntityStore.positions[mSlot].x += gEntityStore.velocities[mSlot].x * deltaTime;
+        checkCollisionX(collidableEntities, collisionCheckCount);
+        checkCollisionX(collidables);
+        checkCollisionX(map);
+
+        // APPLY Y MOVEMENT & COLLISION
+        gEntityStore.positions[mSlot].y += gEntityStore.velocities[mSlot].y * deltaTime;
+        checkCollisionY(collidableEntities, collisionCheckCount);
+        checkCollisionY(collidables);
+        checkCollisionY(map);
+    }
 
 
     // ANIMATE
     // Animate when moving; also allow idle animation for bosses
-    if (mTextureType == ATLAS && (Vector2Length(mMovement) != 0 || mAIType == AI_BOSS))
+    if (gEntityStore.textureTypes[mSlot] == ATLAS && (Vector2Length(gEntityStore.movements[mSlot]) != 0 || gEntityStore.aiTypes[mSlot] == AI_BOSS))
         animate(deltaTime);
     }
 }
 
-void Entity::render()
+bool Entity::getSpriteQuad(SpriteQuad &quad) const
 {
-    if(mEntityStatus == INACTIVE) return;
+    if(gEntityStore.statuses[mSlot] == INACTIVE) return false;
 
-    Rectangle textureArea;
+    Rectangle textureArea = { 0.0f, 0.0f, 0.0f, 0.0f };
 
-    switch (mTextureType)
+    switch (gEntityStore.textureTypes[mSlot])
     {
         case SINGLE:
             textureArea = {
                 0.0f, 0.0f,
-                static_cast<float>(mTexture.width),
-                static_cast<float>(mTexture.height)
+                static_cast<float>(gEntityStore.textures[mSlot].width),
+                static_cast<float>(gEntityStore.textures[mSlot].height)
             };
             break;
         case ATLAS:
         {
             int index = 0;
-            if (Vector2Length(mMovement) > 0.0f && !mAnimationIndices.empty()) {
-                index = mAnimationIndices[mCurrentFrameIndex];
+            const AnimationSet *animationSet = gEntityStore.animationSets[mSlot];
+            if (Vector2Length(gEntityStore.movements[mSlot]) > 0.0f && animationSet != nullptr) {
+                // Clips differ in length, so wrap the cursor for the current one
+                const AnimationClip &clip = animationSet->getClip(gEntityStore.directions[mSlot]);
+                if (clip.frameCount > 0)
+                    index = clip.frames[gEntityStore.frameIndices[mSlot] % clip.frameCount];
             } // else stay at atlas (0,0) -> index 0 when idle
             textureArea = getUVRectangle(
-                &mTexture,
+                &gEntityStore.textures[mSlot],
                 index,
-                mSpriteSheetDimensions.x,
-                mSpriteSheetDimensions.y
+                gEntityStore.spriteSheetDimensions[mSlot].x,
+                gEntityStore.spriteSheetDimensions[mSlot].y
             );
         }
             break;
@@ -490,38 +590,56 @@ void Entity::render()
     // If sprite faces Right (default): Flip when moving Left.
     // If sprite faces Left (new enemy): Flip when moving Right.
     bool shouldFlip = false;
-    if (!mSpriteFacesLeft && mDirection == LEFT)  shouldFlip = true;
-    if ( mSpriteFacesLeft && mDirection == RIGHT) shouldFlip = true;
+    if (!gEntityStore.spriteFacesLeft[mSlot] && gEntityStore.directions[mSlot] == LEFT)  shouldFlip = true;
+    if ( gEntityStore.spriteFacesLeft[mSlot] && gEntityStore.directions[mSlot] == RIGHT) shouldFlip = true;
     if (shouldFlip) {
         textureArea.width *= -1.0f;
     }
 
+    Vector2 renderPosition = gEntityStore.getRenderPosition(mSlot);
     Rectangle destinationArea = {
-        mPosition.x,
-        mPosition.y,
-        static_cast<float>(mScale.x),
-        static_cast<float>(mScale.y)
+        renderPosition.x,
+        renderPosition.y,
+        static_cast<float>(gEntityStore.scales[mSlot].x),
+        static_cast<float>(gEntityStore.scales[mSlot].y)
     };
 
     Vector2 originOffset = {
-        static_cast<float>(mScale.x) / 2.0f,
-        static_cast<float>(mScale.y) / 2.0f
+        static_cast<float>(gEntityStore.scales[mSlot].x) / 2.0f,
+        static_cast<float>(gEntityStore.scales[mSlot].y) / 2.0f
     };
 
-    DrawTexturePro(
-        mTexture, 
+    quad = {
+        gEntityStore.textures[mSlot], 
         textureArea, destinationArea, originOffset,
-        mAngle, mTint
-    );
+        gEntityStore.angles[mSlot], gEntityStore.tints[mSlot]
+    };
+    return true;
+}
+
+void Entity::render()
+{
+    SpriteQuad quad;
+    if (!getSpriteQuad(quad)) return;
+
+    DrawTexturePro(quad.texture, quad.source, quad.destination,
+        quad.origin, quad.rotation, quad.tint);
+}
+
+void Entity::render(SpriteBatch *batch, int layer) const
+{
+    SpriteQuad quad;
+    if (getSpriteQuad(quad)) batch->submit(quad, layer);
 }
 
 void Entity::displayCollider() 
 {
+    Vector2 renderPosition = gEntityStore.getRenderPosition(mSlot);
     Rectangle colliderBox = {
-        mPosition.x - mColliderDimensions.x / 2.0f,  
-        mPosition.y - mColliderDimensions.y / 2.0f,  
-        mColliderDimensions.x,                        
-        mColliderDimensions.y                        
+        renderPosition.x - gEntityStore.colliderDimensions[mSlot].x / 2.0f,  
+        renderPosition.y - gEntityStore.colliderDimensions[mSlot].y / 2.0f,  
+        gEntityStore.colliderDimensions[mSlot].x,                        
+        gEntityStore.colliderDimensions[mSlot].y                        
     };
 
     DrawRectangleLines(
@@ -535,7 +653,7 @@ void Entity::displayCollider()
 
 Vector2 Entity::getDirectionVector() const
 {
-    switch (mDirection) {
+    switch (gEntityStore.directions[mSlot]) {
         case LEFT:  return { -1.0f,  0.0f };
         case RIGHT: return {  1.0f,  0.0f };
         case UP:    return {  0.0f, -1.0f };
@@ -576,6 +694,34 @@ bool Entity::isEntityInSight(Entity* other, float viewDistance, float viewAngleD
     return (dot > threshold);
 }
 
+bool Entity::sensePlayer(Entity* player, Map* map)
+{
+    if (!player) return false;
+
+    switch (gEntityStore.aiTypes[mSlot])
+    {
+    case AI_GUARD:
+    {
+        //  Preliminary Cone Check (Distance & Angle)
+        if (!isEntityInSight(player, 100.0f, 90.0f)) return false;
+
+        //  Raycast Check
+        // If the simple cone check passes, we must verify NO WALLS exist between them.
+        if (map != nullptr && !map->hasLineOfSight(gEntityStore.positions[mSlot], player->getPosition()))
+            return false; // Blocked by wall -> Player is safe
+
+        return true;
+    }
+
+    case AI_SEARCHLIGHT:
+        // Longer/narrower vision cone; sweeps over walls
+        return isEntityInSight(player, 150.0f, 45.0f);
+
+    default:
+        return false;
+    }
+}
+
 // Attacker is considered "behind" victim if they face roughly the same direction.
 // Dot > 0.5 considered acceptable.
 bool Entity::checkAmbush(Entity* victim)
@@ -601,13 +747,13 @@ static bool CanPlaceEntityAt(Map* map, Vector2 pos, Vector2 colliderDimensions)
     if (map->isSolidTileAt(rightCentre, &xo, &yo))  return false;
     return true;
 }
-void Entity::updateFollowerPhysics(Entity* leader, const std::vector<Entity*>& followers,
+void Entity::updateFollowerPhysics(Entity* leader, const SpatialHash* followers,
     Map* map, float deltaTime, float tetherSpeed, float repelStrength,
-    float jitterStrength, float damping)
+    float jitterStrength, float damping, RandomStream &rng)
 {
-    if (mEntityType != NPC || mAIType != AI_FOLLOWER || leader == nullptr) return;
+    if (gEntityStore.types[mSlot] != NPC || gEntityStore.aiTypes[mSlot] != AI_FOLLOWER || leader == nullptr) return;
 
-    Vector2 currentPos = mPosition;
+    Vector2 currentPos = gEntityStore.positions[mSlot];
     const float IDLE_SPEED_THRESHOLD = 12.0f;   // px/s considered idle
     const float STOP_FOLLOW_DISTANCE = 80.0f;   // within this, stop physics
 
@@ -616,7 +762,7 @@ void Entity::updateFollowerPhysics(Entity* leader, const std::vector<Entity*>& f
     if (Vector2Distance(currentPos, leader->getPosition()) > TELEPORT_DISTANCE)
     {
         Vector2 leaderPos = leader->getPosition();
-        float radius = fmaxf(mColliderDimensions.x, mColliderDimensions.y) + 8.0f; // small buffer
+        float radius = fmaxf(gEntityStore.colliderDimensions[mSlot].x, gEntityStore.colliderDimensions[mSlot].y) + 8.0f; // small buffer
 
         // Preferred spot is behind the leader relative to facing
         Vector2 behind = Vector2Scale(leader->getDirectionVector(), -1.0f);
@@ -635,13 +781,13 @@ void Entity::updateFollowerPhysics(Entity* leader, const std::vector<Entity*>& f
         {
             Vector2 dir = (Vector2Length(d) > 0.0f) ? Vector2Normalize(d) : d;
             Vector2 candidate = Vector2Add(leaderPos, Vector2Scale(dir, radius));
-            if (CanPlaceEntityAt(map, candidate, mColliderDimensions)) { chosenPos = candidate; placed = true; break; }
+            if (CanPlaceEntityAt(map, candidate, gEntityStore.colliderDimensions[mSlot])) { chosenPos = candidate; placed = true; break; }
         }
 
         // Teleport and reset motion; also refresh breadcrumb
-        mPosition = chosenPos;
-        mVelocity = {0.0f, 0.0f};
-        mMovement = {0.0f, 0.0f};
+        setPosition(chosenPos); // drawn there this frame, not lerped across the jump
+        gEntityStore.velocities[mSlot] = {0.0f, 0.0f};
+        gEntityStore.movements[mSlot] = {0.0f, 0.0f};
         resetColliderFlags();
 
         // No further physics this frame
@@ -652,10 +798,10 @@ void Entity::updateFollowerPhysics(Entity* leader, const std::vector<Entity*>& f
     float distToLeader = Vector2Distance(currentPos, leader->getPosition());
     if (distToLeader < STOP_FOLLOW_DISTANCE)
     {
-        mVelocity = {0.0f, 0.0f};
-        mMovement = {0.0f, 0.0f};
-        mIsCollidingLeft = mIsCollidingRight = mIsCollidingTop = mIsCollidingBottom = false;
-        mDirection = NEUTRAL;
+        gEntityStore.velocities[mSlot] = {0.0f, 0.0f};
+        gEntityStore.movements[mSlot] = {0.0f, 0.0f};
+        gEntityStore.collidingLeft[mSlot] = gEntityStore.collidingRight[mSlot] = gEntityStore.collidingTop[mSlot] = gEntityStore.collidingBottom[mSlot] = false;
+        gEntityStore.directions[mSlot] = NEUTRAL;
         return;
     }
 
@@ -676,10 +822,11 @@ void Entity::updateFollowerPhysics(Entity* leader, const std::vector<Entity*>& f
             separation = Vector2Add(separation, Vector2Scale(pushDir, scale));
         }
     }
-    // Repel from other followers
-    for (size_t i = 0; i < followers.size(); ++i) {
-        Entity* neighbor = followers[i];
-        if (neighbor == nullptr || neighbor == this) continue;
+    // Repel from other followers (only those in nearby cells can be in range)
+    gNearbyEntities.clear();
+    if (followers != nullptr) followers->queryRadius(currentPos, 30.0f, gNearbyEntities);
+    for (Entity* neighbor : gNearbyEntities) {
+        if (neighbor == this) continue;
         float dist = Vector2Distance(currentPos, neighbor->getPosition());
         if (dist < 30.0f) {
             if (dist < 1.0f) dist = 1.0f;
@@ -691,11 +838,13 @@ void Entity::updateFollowerPhysics(Entity* leader, const std::vector<Entity*>& f
     }
 
     // IDLE JITTER (Ambient life)
+    // Each follower runs its own clock from a random phase, so they sway out of step
+    if (gEntityStore.jitterPhases[mSlot] < 0.0f) gEntityStore.jitterPhases[mSlot] = rng.nextFloat() * 2.0f * PI;
+    gEntityStore.jitterPhases[mSlot] += deltaTime;
     Vector2 jitter = {0.0f, 0.0f};
-    if (Vector2Length(mVelocity) < 5.0f) {
-        float time = GetTime();
-        float entityID = static_cast<float>((reinterpret_cast<uintptr_t>(this) & 0xFFF));
-        Vector2 noise = { sinf(time + entityID), cosf(time + entityID) };
+    if (Vector2Length(gEntityStore.velocities[mSlot]) < 5.0f) {
+        float phase = gEntityStore.jitterPhases[mSlot];
+        Vector2 noise = { sinf(phase), cosf(phase) };
         jitter = Vector2Scale(noise, jitterStrength);
     }
 
@@ -705,44 +854,47 @@ void Entity::updateFollowerPhysics(Entity* leader, const std::vector<Entity*>& f
     acceleration = Vector2Add(acceleration, jitter);
 
     // Apply to velocity (note: remove extra deltaTime factor to avoid tiny movement)
-    mVelocity = Vector2Add(mVelocity, acceleration);
+    gEntityStore.velocities[mSlot] = Vector2Add(gEntityStore.velocities[mSlot], acceleration);
     // Clamp max velocity to avoid jitter explosions
     const float MAX_FOLLOWER_SPEED = 250.0f; // pixels/second (similar to DEFAULT_SPEED)
-    float velMag = Vector2Length(mVelocity);
+    float velMag = Vector2Length(gEntityStore.velocities[mSlot]);
     if (velMag > MAX_FOLLOWER_SPEED) {
-        mVelocity = Vector2Scale(Vector2Normalize(mVelocity), MAX_FOLLOWER_SPEED);
+        gEntityStore.velocities[mSlot] = Vector2Scale(Vector2Normalize(gEntityStore.velocities[mSlot]), MAX_FOLLOWER_SPEED);
     }
     // Apply damping (frictional decay)
-    mVelocity = Vector2Scale(mVelocity, damping);
+    gEntityStore.velocities[mSlot] = Vector2Scale(gEntityStore.velocities[mSlot], damping);
 
     // Collision preparation
     resetColliderFlags();
 
-    // Move X then collide
-    mPosition.x += mVelocity.x * deltaTime;
-    checkCollisionX(map);
-    // Move Y then collide
-    mPosition.y += mVelocity.y * deltaTime;
-    checkCollisionY(map);
+    {
+        PROFILE_SCOPE(PROFILE_COLLISION);
+        // Move X then collide
+        gEntityStore.positions[mSlot].x += gEntityStore.velocities[mSlot].x * deltaTime;
+        checkCollisionX(map);
+        // Move Y then collide
+        gEntityStore.positions[mSlot].y += gEntityStore.velocities[mSlot].y * deltaTime;
+        checkCollisionY(map);
+    }
 
     // Breadcrumb recording removed
 
     // Derive movement vector for animation/direction with idle threshold
-    float vmag = Vector2Length(mVelocity);
+    float vmag = Vector2Length(gEntityStore.velocities[mSlot]);
     if (vmag > IDLE_SPEED_THRESHOLD) {
-        mMovement = Vector2Normalize(mVelocity);
-        if (fabs(mVelocity.x) > fabs(mVelocity.y)) {
-            mDirection = (mVelocity.x < 0) ? LEFT : RIGHT;
+        gEntityStore.movements[mSlot] = Vector2Normalize(gEntityStore.velocities[mSlot]);
+        if (fabs(gEntityStore.velocities[mSlot].x) > fabs(gEntityStore.velocities[mSlot].y)) {
+            gEntityStore.directions[mSlot] = (gEntityStore.velocities[mSlot].x < 0) ? LEFT : RIGHT;
         } else {
-            mDirection = (mVelocity.y < 0) ? UP : DOWN;
+            gEntityStore.directions[mSlot] = (gEntityStore.velocities[mSlot].y < 0) ? UP : DOWN;
         }
     } else {
-        mMovement = {0.0f, 0.0f};
-        mDirection = NEUTRAL;
+        gEntityStore.movements[mSlot] = {0.0f, 0.0f};
+        gEntityStore.directions[mSlot] = NEUTRAL;
     }
 
     // Animation (if atlas)
-    if (mTextureType == ATLAS && Vector2Length(mVelocity) > IDLE_SPEED_THRESHOLD) {
+    if (gEntityStore.textureTypes[mSlot] == ATLAS && Vector2Length(gEntityStore.velocities[mSlot]) > IDLE_SPEED_THRESHOLD) {
         animate(deltaTime);
     }
 }
@@ -2,97 +2,38 @@
 #define ENTITY_H
 
 #include "Map.h"
+#include "AssetCache.h"
+#include "EntityStore.h"
+#include "AnimationSet.h"
+#include "SpriteBatch.h"
+#include "Random.h"
 
-enum Direction    { LEFT, UP, RIGHT, DOWN, NEUTRAL     };
-enum EntityStatus { ACTIVE, INACTIVE                   };
-enum EntityType   { PLAYER, BLOCK, PLATFORM, NPC, PROP, NONE };
-// Updated AI enums (Phase 1: Patrol/Chase/Return behaviors)
-enum AIType { 
-    AI_GUARD,      // Patrols and chases
-    AI_SENTRY,     // Stationary until player close
-    AI_BOSS,       // Stationary boss: animates, no chase
-    AI_TRAP,       // Moving hazard (invincible)
-    AI_SEARCHLIGHT, // Patrols; triggers global alarm, no combat
-    AI_NONE,
-    AI_FOLLOWER 
-};
-
-enum AIState { 
-    IDLE,        // Inactive / waiting
-    PATROLLING,  // Moving between waypoints
-    CHASING,     // Pursuing player
-    RETURNING,   // Returning to start position
-    AI_AWAKENED  // Alerted (used by searchlight/sentries)
-};
+class SpatialHash;
 
 class Entity
 {
 private:
-    Vector2 mPosition;
-    Vector2 mMovement;
-    Vector2 mVelocity;
-    Vector2 mAcceleration; 
-
-    Vector2 mScale;
-    Vector2 mColliderDimensions;
-    
-    Texture2D mTexture;
-    TextureType mTextureType;
-    Vector2 mSpriteSheetDimensions;
-    Color mTint = WHITE;
-    
-    std::map<Direction, std::vector<int>> mAnimationAtlas;
-    std::vector<int> mAnimationIndices;
-    Direction mDirection;
-    int mFrameSpeed;
-
-    int mCurrentFrameIndex = 0;
-    float mAnimationTime = 0.0f;
-
-
-    int mSpeed;
-    float mAngle;
-
-    bool mIsCollidingTop    = false;
-    bool mIsCollidingBottom = false;
-    bool mIsCollidingRight  = false;
-    bool mIsCollidingLeft   = false;
-
-    EntityStatus mEntityStatus = ACTIVE;
-    EntityType   mEntityType;
-
-    AIType  mAIType;
-    AIState mAIState;
-    
-    // Global alarm timer holder (used on Player)
-    float mAlarmTimer = 0.0f;
-
-    // Prop flags
-    bool mIsChest = false;
-
-    // Patrol / AI navigation data
-    Vector2 mStartPosition;    // Original post/guard position
-    Vector2 mPatrolTarget;     // Current patrol waypoint
-    float   mWaitTimer = 0.0f; // Time waiting at a waypoint
-
-    // Sprite facing source orientation. If false, source faces Right (default);
-    // if true, source faces Left (new enemy asset).
-    bool mSpriteFacesLeft = false; // NEW: Defaults to false (Standard Right-facing)
-
-    // Follower System: Breadcrumbs (REMOVED: not used by follower physics)
+    // Every field lives in gEntityStore; the entity is a handle to its slot
+    int mSlot;
 
     void checkCollisionY(Entity *collidableEntities, int collisionCheckCount);
+    void checkCollisionY(const SpatialHash *collidables);
     void checkCollisionY(Map *map);
 
     void checkCollisionX(Entity *collidableEntities, int collisionCheckCount);
+    void checkCollisionX(const SpatialHash *collidables);
     void checkCollisionX(Map *map);
+
+    // Pushes this entity out of one overlapping entity along an axis
+    void resolveCollisionY(Entity *collidableEntity);
+    void resolveCollisionX(Entity *collidableEntity);
     
     void resetColliderFlags() 
     {
-        mIsCollidingTop    = false;
-        mIsCollidingBottom = false;
-        mIsCollidingRight  = false;
-        mIsCollidingLeft   = false;
+        gEntityStore.collidingTop[mSlot]    = false;
+        gEntityStore.collidingBottom[mSlot] = false;
+        gEntityStore.collidingRight[mSlot]  = false;
+        gEntityStore.collidingLeft[mSlot]   = false;
     }
 
     void animate(float deltaTime);
@@ -101,8 +42,16 @@ private:
     void aiExecute(Entity* player, Map* map, float deltaTime);
     void aiGuard(Entity* player, Map* map, float deltaTime);
     void aiPatrol(float deltaTime);
-    void aiChase(Entity* player, float deltaTime);
+    void aiChase(Entity* player, Map* map, float deltaTime);
     void moveTowards(Vector2 target, float deltaTime);
+    // Steers along a cached A* route to target (replanned when the goal,
+    // the map or the agent's position drifts); straight line without a map
+    void followPath(Map* map, Vector2 target, float deltaTime);
+
+    // Shared body of both update() overloads
+    void updateMotion(float deltaTime, Entity *player, Map *map,
+        Entity *collidableEntities, int collisionCheckCount,
+        const SpatialHash *collidables);
 
 public:
     static constexpr int   DEFAULT_SIZE          = 250;
@@ -119,115 +68,134 @@ public:
         EntityType entityType);
     ~Entity();
 
+    // A handle owns its slot, so entities cannot be copied
+    Entity(const Entity &) = delete;
+    Entity &operator=(const Entity &) = delete;
+
+    int getSlot() const { return mSlot; }
+
     void update(float deltaTime, Entity *player, Map *map, 
         Entity *collidableEntities, int collisionCheckCount);
+    // Same, but only tests the collidables registered near this entity
+    void update(float deltaTime, Entity *player, Map *map,
+        const SpatialHash *collidables);
     void render();
-    void normaliseMovement() { Normalise(&mMovement); }
-
-    void activate()   { mEntityStatus  = ACTIVE;   }
-    void deactivate() { mEntityStatus  = INACTIVE; }
+    // Queues the sprite in a batch instead of drawing it now
+    void render(SpriteBatch *batch, int layer) const;
+    // The quad render() would draw; false when inactive
+    bool getSpriteQuad(SpriteQuad &quad) const;
+    void normaliseMovement() { Normalise(&gEntityStore.movements[mSlot]); }
+
+    void activate()   { gEntityStore.statuses[mSlot]  = ACTIVE;  }
+    void deactivate() { gEntityStore.statuses[mSlot]  = INACTIVE; }
     void displayCollider();
 
-    bool isActive() { return mEntityStatus == ACTIVE ? true : false; }
+    bool isActive() { return gEntityStore.statuses[mSlot] == ACTIVE ? true : false; }
     
     bool isColliding(Entity *other) const;
 
     // Updated Movement Setters
-    void moveUp()    { mMovement.y = -1; mDirection = UP;    }
-    void moveDown()  { mMovement.y =  1; mDirection = DOWN;  }
-    void moveLeft()  { mMovement.x = -1; mDirection = LEFT;  }
-    void moveRight() { mMovement.x =  1; mDirection = RIGHT; }
+    void moveUp()    { gEntityStore.movements[mSlot].y = -1; gEntityStore.directions[mSlot] = UP;  }
+    void moveDown()  { gEntityStore.movements[mSlot].y =  1; gEntityStore.directions[mSlot] = DOWN;  }
+    void moveLeft()  { gEntityStore.movements[mSlot].x = -1; gEntityStore.directions[mSlot] = LEFT;  }
+    void moveRight() { gEntityStore.movements[mSlot].x =  1; gEntityStore.directions[mSlot] = RIGHT; }
 
-    void resetMovement() { mMovement = { 0.0f, 0.0f }; }
+    void resetMovement() { gEntityStore.movements[mSlot] = { 0.0f, 0.0f }; }
 
     // Stealth / Ambush Helpers
     Vector2 getDirectionVector() const; // New helper for Dot Product calculation
     bool isEntityInSight(Entity* other, float viewDistance = 150.0f, float viewAngleDeg = 90.0f); // View cone check (defaults)
     bool checkAmbush(Entity* victim); // Direction alignment (attacker behind victim)
 
+    // Perception: the full sight test for this AI type (guards: cone + line
+    // of sight; searchlights: long narrow cone). An AIScheduler runs it at a
+    // rate suited to the enemy and caches the result with setPerception();
+    // the AI and the scenes read the cache instead of repeating the query.
+    bool sensePlayer(Entity* player, Map* map);
+    void setPerception(bool canSeePlayer)
+    {
+        gEntityStore.hasPerception[mSlot]   = true;
+        gEntityStore.perceivesPlayer[mSlot] = canSeePlayer;
+    }
+    bool hasPerception() const { return gEntityStore.hasPerception[mSlot];   }
+    bool canSeePlayer()  const { return gEntityStore.perceivesPlayer[mSlot]; }
+
     // Getters
-    Vector2     getPosition()              const { return mPosition;              }
-    Vector2     getMovement()              const { return mMovement;              }
-    Vector2     getVelocity()              const { return mVelocity;              }
-    Vector2     getScale()                 const { return mScale;                 }
-    Vector2     getColliderDimensions()    const { return mScale;                 }
-    Vector2     getSpriteSheetDimensions() const { return mSpriteSheetDimensions; }
-    Texture2D   getTexture()               const { return mTexture;               }
-    TextureType getTextureType()           const { return mTextureType;           }
-    Direction   getDirection()             const { return mDirection;             }
-    int         getFrameSpeed()            const { return mFrameSpeed;            }
-    int         getSpeed()                 const { return mSpeed;                 }
-    float       getAngle()                 const { return mAngle;                 }
-    EntityType  getEntityType()            const { return mEntityType;            }
-    AIType      getAIType()                const { return mAIType;                }
-    AIState     getAIState()               const { return mAIState;               }
-
-    bool isCollidingTop()    const { return mIsCollidingTop;    }
-    bool isCollidingBottom() const { return mIsCollidingBottom; }
-    bool isCollidingLeft()   const { return mIsCollidingLeft;   }
-    bool isCollidingRight()  const { return mIsCollidingRight;  }
-
-    std::map<Direction, std::vector<int>> getAnimationAtlas() const { return mAnimationAtlas; }
+    Vector2     getPosition()              const { return gEntityStore.positions[mSlot];  }
+    // Where to draw this frame (between the last two simulation ticks)
+    Vector2     getRenderPosition()        const { return gEntityStore.getRenderPosition(mSlot); }
+    Vector2     getMovement()              const { return gEntityStore.movements[mSlot];  }
+    Vector2     getVelocity()              const { return gEntityStore.velocities[mSlot];  }
+    Vector2     getScale()                 const { return gEntityStore.scales[mSlot];  }
+    Vector2     getColliderDimensions()    const { return gEntityStore.scales[mSlot];  }
+    Vector2     getSpriteSheetDimensions() const { return gEntityStore.spriteSheetDimensions[mSlot]; }
+    Texture2D   getTexture()               const { return gEntityStore.textures[mSlot];  }
+    TextureType getTextureType()           const { return gEntityStore.textureTypes[mSlot];  }
+    Direction   getDirection()             const { return gEntityStore.directions[mSlot];  }
+    int         getFrameSpeed()            const { return gEntityStore.frameSpeeds[mSlot];  }
+    int         getSpeed()                 const { return gEntityStore.speeds[mSlot];  }
+    float       getAngle()                 const { return gEntityStore.angles[mSlot];  }
+    EntityType  getEntityType()            const { return gEntityStore.types[mSlot];  }
+    AIType      getAIType()                const { return gEntityStore.aiTypes[mSlot];  }
+    AIState     getAIState()               const { return gEntityStore.aiStates[mSlot];  }
+
+    bool isCollidingTop()    const { return gEntityStore.collidingTop[mSlot];  }
+    bool isCollidingBottom() const { return gEntityStore.collidingBottom[mSlot]; }
+    bool isCollidingLeft()   const { return gEntityStore.collidingLeft[mSlot];  }
+    bool isCollidingRight()  const { return gEntityStore.collidingRight[mSlot];  }
+
+    const AnimationSet *getAnimationSet() const { return gEntityStore.animationSets[mSlot]; }
 
     // Setters
-    void setPosition(Vector2 newPosition)       { mPosition = newPosition;                 }
-    void setMovement(Vector2 newMovement)       { mMovement = newMovement;                 }
-    void setAcceleration(Vector2 newAcceleration){ mAcceleration = newAcceleration;         }
-    void setScale(Vector2 newScale)             { mScale = newScale;                       }
-    void setTexture(const char *textureFilepath){ mTexture = LoadTexture(textureFilepath); }
-    void setTextureType(TextureType type)        { mTextureType = type;                      }
-    void setColliderDimensions(Vector2 newDimensions) { mColliderDimensions = newDimensions; }
-    void setSpriteSheetDimensions(Vector2 newDimensions) { mSpriteSheetDimensions = newDimensions; }
-    void setAnimationAtlas(const std::map<Direction, std::vector<int>>& atlas)
+    // Places the entity; it is drawn there immediately, not interpolated from the old spot
+    void setPosition(Vector2 newPosition)
     {
-        mAnimationAtlas = atlas;
-        if (mTextureType == ATLAS) {
-            auto it = mAnimationAtlas.find(mDirection);
-            if (it != mAnimationAtlas.end()) {
-                mAnimationIndices = it->second;
-            } else if (!mAnimationAtlas.empty()) {
-                // Fallback to RIGHT if present, else first available
-                auto rt = mAnimationAtlas.find(RIGHT);
-                mAnimationIndices = (rt != mAnimationAtlas.end()) ? rt->second : mAnimationAtlas.begin()->second;
-            }
-        }
+        gEntityStore.positions[mSlot]         = newPosition;
+        gEntityStore.previousPositions[mSlot] = newPosition;
     }
-    void setSpeed(int newSpeed)                 { mSpeed  = newSpeed;                      }
-    void setFrameSpeed(int newSpeed)            { mFrameSpeed = newSpeed;                  }
-    void setAngle(float newAngle)               { mAngle = newAngle;                       }
-    void setEntityType(EntityType entityType)   { mEntityType = entityType;                }
-    void setDirection(Direction newDirection)
-    { 
-        mDirection = newDirection;
-        if (mTextureType == ATLAS) {
-            auto it = mAnimationAtlas.find(mDirection);
-            if (it != mAnimationAtlas.end()) {
-                mAnimationIndices = it->second;
-            } else if (!mAnimationAtlas.empty()) {
-                auto rt = mAnimationAtlas.find(RIGHT);
-                mAnimationIndices = (rt != mAnimationAtlas.end()) ? rt->second : mAnimationAtlas.begin()->second;
-            }
-        }
+    void setMovement(Vector2 newMovement)       { gEntityStore.movements[mSlot] = newMovement;  }
+    void setAcceleration(Vector2 newAcceleration){ gEntityStore.accelerations[mSlot] = newAcceleration;  }
+    void setScale(Vector2 newScale)             { gEntityStore.scales[mSlot] = newScale;  }
+    void setTexture(const char *textureFilepath)
+    {
+        // Swap references in the shared cache rather than loading a private copy
+        gAssetCache.releaseTexture(gEntityStore.textures[mSlot]);
+        gEntityStore.textures[mSlot] = gAssetCache.acquireTexture(textureFilepath);
+    }
+    void setTextureType(TextureType type)        { gEntityStore.textureTypes[mSlot] = type;  }
+    void setColliderDimensions(Vector2 newDimensions) { gEntityStore.colliderDimensions[mSlot] = newDimensions; }
+    void setSpriteSheetDimensions(Vector2 newDimensions) { gEntityStore.spriteSheetDimensions[mSlot] = newDimensions; }
+    // Compiles (or reuses) the shared clip table for this atlas
+    void setAnimationAtlas(const std::map<Direction, std::vector<int>>& atlas)
+    {
+        gEntityStore.animationSets[mSlot] = internAnimationSet(atlas);
     }
-    void setTint(Color color)                   { mTint = color;                           }
-    void setAIState(AIState newState)           { mAIState = newState;                     }
-    void setAIType(AIType newType)              { mAIType = newType;                       }
-    void setStartPosition(Vector2 pos)          { mStartPosition = pos;                    }
-    void setPatrolTarget(Vector2 pos)           { mPatrolTarget  = pos;                    }
-    void setAlarmTimer(float t)                 { mAlarmTimer = t;                         }
-    void setIsChest(bool v)                     { mIsChest = v;                            }
+    void setSpeed(int newSpeed)                 { gEntityStore.speeds[mSlot]  = newSpeed;  }
+    void setFrameSpeed(int newSpeed)            { gEntityStore.frameSpeeds[mSlot] = newSpeed;  }
+    void setAngle(float newAngle)               { gEntityStore.angles[mSlot] = newAngle;  }
+    void setEntityType(EntityType entityType)   { gEntityStore.types[mSlot] = entityType;  }
+    void setDirection(Direction newDirection)   { gEntityStore.directions[mSlot] = newDirection;  }
+    void setTint(Color color)                   { gEntityStore.tints[mSlot] = color;  }
+    void setAIState(AIState newState)           { gEntityStore.aiStates[mSlot] = newState;  }
+    void setAIType(AIType newType)              { gEntityStore.aiTypes[mSlot] = newType;  }
+    void setStartPosition(Vector2 pos)          { gEntityStore.startPositions[mSlot] = pos;  }
+    void setPatrolTarget(Vector2 pos)           { gEntityStore.patrolTargets[mSlot]  = pos;  }
+    void setAlarmTimer(float t)                 { gEntityStore.alarmTimers[mSlot] = t;  }
+    void setIsChest(bool v)                     { gEntityStore.isChest[mSlot] = v;  }
 
     // NEW Setter: configure sprite source facing direction
-    void setSourceFacing(bool facesLeft) { mSpriteFacesLeft = facesLeft; }
+    void setSourceFacing(bool facesLeft) { gEntityStore.spriteFacesLeft[mSlot] = facesLeft; }
 
-    // Advanced follower physics (tether + separation + jitter + integration)
-    void updateFollowerPhysics(Entity* leader, const std::vector<Entity*>& followers,
+    // Advanced follower physics (tether + separation + jitter + integration).
+    // Separation only looks at followers registered in the grid near this one;
+    // each follower's jitter phase is drawn from rng the first time.
+    void updateFollowerPhysics(Entity* leader, const SpatialHash* followers,
         Map* map, float deltaTime, float tetherSpeed, float repelStrength,
-        float jitterStrength, float damping);
+        float jitterStrength, float damping, RandomStream &rng);
 
     // Alarm getter
-    float getAlarmTimer() const { return mAlarmTimer; }
-    bool isChest() const { return mIsChest; }
+    float getAlarmTimer() const { return gEntityStore.alarmTimers[mSlot]; }
+    bool isChest() const { return gEntityStore.isChest[mSlot]; }
 };
 
 #endif // ENTITY_H
\ No newline at end of file
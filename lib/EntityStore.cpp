@@ -0,0 +1,131 @@
+#include "EntityStore.h"
+
+EntityStore gEntityStore;
+
+void EntityStore::grow()
+{
+    positions.push_back({});
+    previousPositions.push_back({});
+    movements.push_back({});
+    velocities.push_back({});
+    accelerations.push_back({});
+    scales.push_back({});
+    colliderDimensions.push_back({});
+    speeds.push_back(0);
+
+    collidingTop.push_back(0);
+    collidingBottom.push_back(0);
+    collidingLeft.push_back(0);
+    collidingRight.push_back(0);
+
+    statuses.push_back(ACTIVE);
+    types.push_back(NONE);
+
+    aiTypes.push_back(AI_NONE);
+    aiStates.push_back(IDLE);
+    startPositions.push_back({});
+    patrolTargets.push_back({});
+    waitTimers.push_back(0.0f);
+    alarmTimers.push_back(0.0f);
+    hasPerception.push_back(0);
+    perceivesPlayer.push_back(0);
+    paths.push_back({});
+    pathCursors.push_back(0);
+    pathGoals.push_back({});
+    pathVersions.push_back(0);
+
+    directions.push_back(RIGHT);
+    frameSpeeds.push_back(0);
+    frameIndices.push_back(0);
+    animationTimes.push_back(0.0f);
+
+    textures.push_back({});
+    textureTypes.push_back(SINGLE);
+    spriteSheetDimensions.push_back({});
+    tints.push_back(WHITE);
+    angles.push_back(0.0f);
+    spriteFacesLeft.push_back(0);
+    animationSets.push_back(nullptr);
+
+    isChest.push_back(0);
+
+    jitterPhases.push_back(-1.0f);
+}
+
+void EntityStore::resetSlot(int slot)
+{
+    positions[slot]          = { 0.0f, 0.0f };
+    previousPositions[slot]  = { 0.0f, 0.0f };
+    movements[slot]          = { 0.0f, 0.0f };
+    velocities[slot]         = { 0.0f, 0.0f };
+    accelerations[slot]      = { 0.0f, 0.0f };
+    scales[slot]             = { 0.0f, 0.0f };
+    colliderDimensions[slot] = { 0.0f, 0.0f };
+    speeds[slot]             = 0;
+
+    collidingTop[slot]    = 0;
+    collidingBottom[slot] = 0;
+    collidingLeft[slot]   = 0;
+    collidingRight[slot]  = 0;
+
+    statuses[slot] = ACTIVE;
+    types[slot]    = NONE;
+
+    aiTypes[slot]        = AI_NONE;
+    aiStates[slot]       = IDLE;
+    startPositions[slot] = { 0.0f, 0.0f };
+    patrolTargets[slot]  = { 0.0f, 0.0f };
+    waitTimers[slot]     = 0.0f;
+    alarmTimers[slot]    = 0.0f;
+    hasPerception[slot]   = 0;
+    perceivesPlayer[slot] = 0;
+    paths[slot].clear();
+    pathCursors[slot]    = 0;
+    pathGoals[slot]      = { 0.0f, 0.0f };
+    pathVersions[slot]   = 0;
+
+    directions[slot]     = RIGHT;
+    frameSpeeds[slot]    = 0;
+    frameIndices[slot]   = 0;
+    animationTimes[slot] = 0.0f;
+
+    textures[slot]              = {};
+    textureTypes[slot]          = SINGLE;
+    spriteSheetDimensions[slot] = { 0.0f, 0.0f };
+    tints[slot]                 = WHITE;
+    angles[slot]                = 0.0f;
+    spriteFacesLeft[slot]       = 0;
+    animationSets[slot]         = nullptr;
+
+    isChest[slot] = 0;
+
+    jitterPhases[slot] = -1.0f;
+}
+
+int EntityStore::allocate()
+{
+    int slot;
+    if (!mFreeSlots.empty())
+    {
+        slot = mFreeSlots.top();
+        mFreeSlots.pop();
+    }
+    else
+    {
+        slot = (int) positions.size();
+        grow();
+    }
+
+    resetSlot(slot);
+    mLiveCount++;
+
+    return slot;
+}
+
+void EntityStore::release(int slot)
+{
+    if (slot < 0 || slot >= (int) positions.size()) return;
+
+    mFreeSlots.push(slot);
+    mLiveCount--;
+}
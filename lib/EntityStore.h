@@ -0,0 +1,125 @@
+#include "cs3113.h"
+#include <queue>
+#include <functional>
+
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+class AnimationSet;
+
+enum Direction    { LEFT, UP, RIGHT, DOWN, NEUTRAL     };
+enum EntityStatus { ACTIVE, INACTIVE                   };
+enum EntityType   { PLAYER, BLOCK, PLATFORM, NPC, PROP, NONE };
+// Updated AI enums (Phase 1: Patrol/Chase/Return behaviors)
+enum AIType { 
+    AI_GUARD,      // Patrols and chases
+    AI_SENTRY,     // Stationary until player close
+    AI_BOSS,       // Stationary boss: animates, no chase
+    AI_TRAP,       // Moving hazard (invincible)
+    AI_SEARCHLIGHT, // Patrols; triggers global alarm, no combat
+    AI_NONE,
+    AI_FOLLOWER 
+};
+
+enum AIState { 
+    IDLE,        // Inactive / waiting
+    PATROLLING,  // Moving between waypoints
+    CHASING,     // Pursuing player
+    RETURNING,   // Returning to start position
+    AI_AWAKENED  // Alerted (used by searchlight/sentries)
+};
+
+// Structure-of-arrays storage behind every Entity. An Entity only holds a
+// slot index; each field lives in its own array, so a loop over an enemy
+// array walks packed positions/velocities/AI state instead of whole objects.
+// Slots are handed out lowest-first, which keeps entities created together
+// (e.g. a `new Entity[n]` block) adjacent in every array.
+class EntityStore
+{
+private:
+    std::priority_queue<int, std::vector<int>, std::greater<int>> mFreeSlots;
+    int mLiveCount = 0;
+
+    void grow();
+    void resetSlot(int slot);
+
+public:
+    // Kinematics (hot: touched by every update)
+    std::vector<Vector2> positions;
+    std::vector<Vector2> previousPositions; // positions at the start of the tick
+    std::vector<Vector2> movements;
+    std::vector<Vector2> velocities;
+    std::vector<Vector2> accelerations;
+    std::vector<Vector2> scales;
+    std::vector<Vector2> colliderDimensions;
+    std::vector<int>     speeds;
+
+    // Collision flags from the last update
+    std::vector<unsigned char> collidingTop;
+    std::vector<unsigned char> collidingBottom;
+    std::vector<unsigned char> collidingLeft;
+    std::vector<unsigned char> collidingRight;
+
+    std::vector<EntityStatus> statuses;
+    std::vector<EntityType>   types;
+
+    // AI
+    std::vector<AIType>  aiTypes;
+    std::vector<AIState> aiStates;
+    std::vector<Vector2> startPositions; // original post/guard position
+    std::vector<Vector2> patrolTargets;  // current patrol waypoint
+    std::vector<float>   waitTimers;     // time waiting at a waypoint
+    std::vector<float>   alarmTimers;    // global alarm (used on the player)
+
+    // Last perception result from the AI scheduler (see Entity::sensePlayer)
+    std::vector<unsigned char> hasPerception;
+    std::vector<unsigned char> perceivesPlayer;
+
+    // Cached A* route (see Entity::followPath)
+    std::vector<std::vector<Vector2>> paths;        // waypoints; capacity reused
+    std::vector<int>                  pathCursors;  // next waypoint
+    std::vector<Vector2>              pathGoals;    // goal the route was planned for
+    std::vector<unsigned int>         pathVersions; // Map nav version when planned
+
+    // Animation cursors
+    std::vector<Direction> directions;
+    std::vector<int>       frameSpeeds;
+    std::vector<int>       frameIndices;
+    std::vector<float>     animationTimes;
+
+    // Rendering (cold: only read by render())
+    std::vector<Texture2D>     textures;
+    std::vector<TextureType>   textureTypes;
+    std::vector<Vector2>       spriteSheetDimensions;
+    std::vector<Color>         tints;
+    std::vector<float>         angles;
+    std::vector<unsigned char> spriteFacesLeft;
+    std::vector<const AnimationSet*> animationSets; // shared, see internAnimationSet()
+
+    // Props
+    std::vector<unsigned char> isChest;
+
+    // Follower idle-jitter clock (seconds, from a random start; < 0 = not drawn yet)
+    std::vector<float> jitterPhases;
+
+    // Returns a slot with every field at its default
+    int  allocate();
+    void release(int slot);
+
+    // Fixed-timestep interpolation: the main loop snapshots positions before
+    // each simulation tick and sets renderAlpha (0..1, how far the frame is
+    // between the last two ticks) before drawing
+    float renderAlpha = 1.0f;
+    void savePreviousPositions() { previousPositions = positions; }
+    Vector2 getRenderPosition(int slot) const
+    {
+        return Vector2Lerp(previousPositions[slot], positions[slot], renderAlpha);
+    }
+
+    int getLiveCount() const { return mLiveCount;              }
+    int getCapacity()  const { return (int) positions.size(); }
+};
+
+extern EntityStore gEntityStore;
+
+#endif // ENTITY_STORE_H
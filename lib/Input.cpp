@@ -0,0 +1,200 @@
+#include "Input.h"
+#include <string.h>
+
+Input gInput;
+
+// Every key the game reads; the bit order is part of the log format, so
+// only ever append to this list
+const int Input::TRACKED_KEYS[] = {
+    KEY_SPACE, KEY_ENTER, KEY_ESCAPE,
+    KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT,
+    KEY_W, KEY_A, KEY_S, KEY_D,
+    KEY_C, KEY_R, KEY_Y, KEY_Z
+};
+const int Input::TRACKED_KEY_COUNT = sizeof(TRACKED_KEYS) / sizeof(TRACKED_KEYS[0]);
+
+static const char LOG_MAGIC[4] = { 'P', '5', 'I', 'N' };
+
+static void writeU16(FILE *file, uint16_t value)
+{
+    fputc(value & 0xFF, file);
+    fputc(value >> 8, file);
+}
+
+static bool readU16(FILE *file, uint16_t *value)
+{
+    int low = fgetc(file), high = fgetc(file);
+    if (low == EOF || high == EOF) return false;
+    *value = (uint16_t)(low | (high << 8));
+    return true;
+}
+
+int Input::keyBit(int key)
+{
+    for (int i = 0; i < TRACKED_KEY_COUNT; i++)
+        if (TRACKED_KEYS[i] == key) return i;
+
+    printf("Input: key %d is not tracked (add it to TRACKED_KEYS)\n", key);
+    return -1;
+}
+
+void Input::poll()
+{
+    mLiveDown = 0;
+    for (int i = 0; i < TRACKED_KEY_COUNT; i++)
+    {
+        if (IsKeyDown(TRACKED_KEYS[i]))    mLiveDown |= (uint16_t)(1u << i);
+        if (IsKeyPressed(TRACKED_KEYS[i])) mLatched  |= (uint16_t)(1u << i);
+    }
+}
+
+void Input::beginTick()
+{
+    // Replayed ticks ignore the keyboard until the log runs out
+    if (mReplayFile && mReplayLeft == 0 && !readRun())
+    {
+        printf("Input: replay finished at tick %lld\n", mTick);
+        fclose(mReplayFile);
+        mReplayFile = nullptr;
+    }
+
+    if (mReplayFile)
+    {
+        mDown    = mReplayDown;
+        mPressed = mReplayPressed;
+        mReplayLeft--;
+    }
+    else
+    {
+        mDown    = mLiveDown;
+        mPressed = mLatched;
+    }
+    mLatched = 0;
+
+    if (mRecordFile)
+    {
+        if (mRunLength > 0 && (mDown != mRunDown || mPressed != mRunPressed)) writeRun();
+        mRunDown    = mDown;
+        mRunPressed = mPressed;
+        mRunLength++;
+    }
+
+    mTick++;
+}
+
+bool Input::isDown(int key) const
+{
+    int bit = keyBit(key);
+    return bit >= 0 && (mDown & (1u << bit));
+}
+
+bool Input::isPressed(int key) const
+{
+    int bit = keyBit(key);
+    return bit >= 0 && (mPressed & (1u << bit));
+}
+
+void Input::writeRun()
+{
+    // Tick count as a varint: 7 bits per byte, high bit = more follows
+    uint32_t length = mRunLength;
+    while (length >= 0x80)
+    {
+        fputc((int)(length & 0x7F) | 0x80, mRecordFile);
+        length >>= 7;
+    }
+    fputc((int) length, mRecordFile);
+
+    writeU16(mRecordFile, mRunDown);
+    writeU16(mRecordFile, mRunPressed);
+    mRunLength = 0;
+}
+
+bool Input::readRun()
+{
+    uint32_t length = 0;
+    for (int shift = 0; ; shift += 7)
+    {
+        int byte = fgetc(mReplayFile);
+        if (byte == EOF || shift > 28) return false;
+        length |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) break;
+    }
+
+    if (!readU16(mReplayFile, &mReplayDown) || !readU16(mReplayFile, &mReplayPressed)) return false;
+    mReplayLeft = length;
+    return length > 0;
+}
+
+bool Input::startRecording(const char *filePath, uint64_t seed)
+{
+    stop();
+
+    mRecordFile = fopen(filePath, "wb");
+    if (!mRecordFile)
+    {
+        printf("Input: cannot record to '%s'\n", filePath);
+        return false;
+    }
+
+    fwrite(LOG_MAGIC, 1, sizeof(LOG_MAGIC), mRecordFile);
+    writeU16(mRecordFile, LOG_VERSION);
+    writeU16(mRecordFile, (uint16_t) TRACKED_KEY_COUNT);
+    for (int i = 0; i < 8; i++) fputc((int)((seed >> (i * 8)) & 0xFF), mRecordFile);
+
+    mRunLength = 0;
+    return true;
+}
+
+bool Input::startReplay(const char *filePath, uint64_t *seed)
+{
+    stop();
+
+    FILE *file = fopen(filePath, "rb");
+    if (!file)
+    {
+        printf("Input: cannot open replay '%s'\n", filePath);
+        return false;
+    }
+
+    char magic[4];
+    uint16_t version = 0, keyCount = 0;
+    bool valid = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                 memcmp(magic, LOG_MAGIC, sizeof(magic)) == 0 &&
+                 readU16(file, &version) && readU16(file, &keyCount);
+
+    uint64_t recordedSeed = 0;
+    for (int i = 0; valid && i < 8; i++)
+    {
+        int byte = fgetc(file);
+        if (byte == EOF) valid = false;
+        else recordedSeed |= (uint64_t) byte << (i * 8);
+    }
+
+    if (!valid || version != LOG_VERSION || keyCount > TRACKED_KEY_COUNT)
+    {
+        printf("Input: '%s' is not a version %d input log\n", filePath, LOG_VERSION);
+        fclose(file);
+        return false;
+    }
+
+    mReplayFile = file;
+    mReplayLeft = 0;
+    if (seed) *seed = recordedSeed;
+    return true;
+}
+
+void Input::stop()
+{
+    if (mRecordFile)
+    {
+        if (mRunLength > 0) writeRun();
+        fclose(mRecordFile);
+        mRecordFile = nullptr;
+    }
+    if (mReplayFile)
+    {
+        fclose(mReplayFile);
+        mReplayFile = nullptr;
+    }
+}
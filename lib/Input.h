@@ -0,0 +1,73 @@
+#include "cs3113.h"
+#include <stdint.h>
+
+#ifndef INPUT_H
+#define INPUT_H
+
+// Keyboard state as the simulation sees it. The game never asks raylib
+// directly: poll() samples the keyboard once per rendered frame, and
+// beginTick() publishes one snapshot per simulation tick, from the live
+// keyboard, or from a replay log. A press is latched until the next tick
+// consumes it, so it is neither lost on a frame that runs no tick nor
+// repeated on a frame that runs two.
+//
+// Log format (little-endian):
+//   header  "P5IN", uint16 version, uint16 tracked key count, uint64 seed
+//   runs    varint tick count, uint16 down mask, uint16 pressed mask
+// Consecutive identical ticks collapse into one run, so idle stretches and
+// held keys cost a few bytes.
+class Input
+{
+private:
+    static const int TRACKED_KEYS[];
+    static const int TRACKED_KEY_COUNT;
+
+    uint16_t mLiveDown    = 0; // keyboard at the last poll()
+    uint16_t mLatched     = 0; // presses since the last tick
+    uint16_t mDown        = 0; // this tick's snapshot
+    uint16_t mPressed     = 0;
+    long long mTick       = 0;
+
+    FILE     *mRecordFile = nullptr;
+    uint32_t  mRunLength  = 0; // ticks in the run being recorded
+    uint16_t  mRunDown    = 0;
+    uint16_t  mRunPressed = 0;
+
+    FILE     *mReplayFile = nullptr;
+    uint32_t  mReplayLeft = 0; // ticks left in the run being replayed
+    uint16_t  mReplayDown = 0;
+    uint16_t  mReplayPressed = 0;
+
+    static int keyBit(int key);
+    void writeRun();
+    bool readRun();
+
+public:
+    static const uint16_t LOG_VERSION = 1;
+
+    // Once per rendered frame
+    void poll();
+    // Once per simulation tick, before anything reads input
+    void beginTick();
+
+    bool isDown(int key)    const;
+    bool isPressed(int key) const;
+
+    // Records every tick from now on, with the session seed in the header
+    bool startRecording(const char *filePath, uint64_t seed);
+    // Replaces the keyboard with the log; seed receives the recorded seed.
+    // Falls back to live input once the log runs out.
+    bool startReplay(const char *filePath, uint64_t *seed);
+    // Flushes and closes any open log
+    void stop();
+
+    bool      isRecording() const { return mRecordFile != nullptr; }
+    bool      isReplaying() const { return mReplayFile != nullptr; }
+    long long getTick()     const { return mTick; }
+
+    ~Input() { stop(); }
+};
+
+extern Input gInput;
+
+#endif // INPUT_H
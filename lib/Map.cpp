@@ -1,19 +1,31 @@
 #include "Map.h"
+#include "Profiler.h"
+#include <algorithm>
+
+constexpr int Map::CHUNK_SIZE;
 
 Map::Map(int mapColumns, int mapRows, unsigned int *levelData,
          const char *textureFilePath, float tileSize, int textureColumns,
          int textureRows, Vector2 origin) : 
          mMapColumns {mapColumns}, mMapRows {mapRows}, 
-         mTextureAtlas { LoadTexture(textureFilePath) },
+         mTextureAtlas { gAssetCache.acquireTexture(textureFilePath) },
          mLevelData {levelData }, mTileSize {tileSize}, 
          mTextureColumns {textureColumns}, mTextureRows {textureRows},
          mOrigin {origin} {
     // Initialize exploration state for all tiles to false
-    mTileExplored.resize(mMapColumns * mMapRows, false);
+    mOwnedExplored.resize(mMapColumns * mMapRows, false);
+    mTileExplored = &mOwnedExplored;
     build();
+    buildWalkability();
+    loadFogMask();
 }
 
-Map::~Map() { UnloadTexture(mTextureAtlas); }
+Map::~Map()
+{
+    unloadChunks();
+    UnloadTexture(mFogMask);
+    gAssetCache.releaseTexture(mTextureAtlas);
+}
 
 void Map::build()
 {
@@ -38,6 +50,129 @@ void Map::build()
             mTextureAreas.push_back(textureArea);
         }
     }
+
+    buildChunks();
+}
+
+void Map::buildChunks()
+{
+    mChunkColumns = (mMapColumns + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    mChunkRows    = (mMapRows    + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    unloadChunks();
+    mChunks.reserve(mChunkColumns * mChunkRows);
+
+    for (int chunkRow = 0; chunkRow < mChunkRows; chunkRow++)
+    {
+        for (int chunkCol = 0; chunkCol < mChunkColumns; chunkCol++)
+        {
+            MapChunk chunk;
+            chunk.firstColumn = chunkCol * CHUNK_SIZE;
+            chunk.firstRow    = chunkRow * CHUNK_SIZE;
+            chunk.columns     = std::min(CHUNK_SIZE, mMapColumns - chunk.firstColumn);
+            chunk.rows        = std::min(CHUNK_SIZE, mMapRows    - chunk.firstRow);
+            chunk.isEmpty     = isChunkEmpty(chunk);
+            chunk.isDirty = !chunk.isEmpty;
+            chunk.cache   = {};
+
+            mChunks.push_back(chunk);
+        }
+    }
+
+    // The level layout is static, so every chunk is drawn once up front
+    bakeDirtyChunks();
+}
+
+bool Map::isChunkEmpty(const MapChunk &chunk) const
+{
+    // Chunks made only of void tiles can be skipped outright when rendering
+    for (int row = chunk.firstRow; row < chunk.firstRow + chunk.rows; row++)
+        for (int col = chunk.firstColumn; col < chunk.firstColumn + chunk.columns; col++)
+            if (mLevelData[row * mMapColumns + col] != 0) return false;
+
+    return true;
+}
+
+void Map::unloadChunks()
+{
+    for (MapChunk &chunk : mChunks)
+        if (chunk.cache.id != 0) UnloadRenderTexture(chunk.cache);
+
+    mChunks.clear();
+}
+
+void Map::bakeChunk(MapChunk &chunk)
+{
+    if (chunk.cache.id == 0)
+    {
+        chunk.cache = LoadRenderTexture((int)(chunk.columns * mTileSize),
+                                        (int)(chunk.rows    * mTileSize));
+    }
+
+    BeginTextureMode(chunk.cache);
+    ClearBackground(BLANK);
+
+    for (int row = 0; row < chunk.rows; row++)
+    {
+        for (int col = 0; col < chunk.columns; col++)
+        {
+            int tile = mLevelData[(chunk.firstRow + row) * mMapColumns + chunk.firstColumn + col];
+            if (tile == 0) continue;
+
+            // Tiles are drawn relative to the chunk's top-left corner
+            DrawTexturePro(
+                mTextureAtlas,
+                mTextureAreas[tile - 1],
+                { col * mTileSize, row * mTileSize, mTileSize, mTileSize },
+                {0.0f, 0.0f},
+                0.0f,
+                WHITE
+            );
+        }
+    }
+
+    EndTextureMode();
+
+    chunk.isDirty = false;
+}
+
+void Map::bakeDirtyChunks()
+{
+    for (MapChunk &chunk : mChunks)
+    {
+        if (!chunk.isDirty) continue;
+
+        if (chunk.isEmpty)
+        {
+            // Nothing left to draw in this chunk, so its cache can go
+            if (chunk.cache.id != 0) UnloadRenderTexture(chunk.cache);
+            chunk.cache   = {};
+            chunk.isDirty = false;
+        }
+        else bakeChunk(chunk);
+    }
+}
+
+void Map::setTile(int col, int row, unsigned int tile)
+{
+    if (col < 0 || col >= mMapColumns || row < 0 || row >= mMapRows) return;
+
+    unsigned int &current = mLevelData[row * mMapColumns + col];
+    if (current == tile) return;
+    current = tile;
+
+    MapChunk &chunk = mChunks[(row / CHUNK_SIZE) * mChunkColumns + col / CHUNK_SIZE];
+    chunk.isDirty = true;
+
+    // Re-evaluate emptiness so a cleared chunk stops being drawn
+    chunk.isEmpty = isChunkEmpty(chunk);
+
+    unsigned char walkable = (tile != 1) ? 1 : 0;
+    if (mWalkable[row * mMapColumns + col] != walkable)
+    {
+        mWalkable[row * mMapColumns + col] = walkable;
+        mNavVersion++;
+    }
 }
 
 int Map::getTileIndex(int x, int y)
@@ -51,16 +186,27 @@ Vector2 Map::worldToTile(Vector2 pos)
     return { (float)((int)(pos.x / mTileSize)), (float)((int)(pos.y / mTileSize)) };
 }
 
-void Map::revealTiles(Vector2 playerPos, float radius)
+TileRegion Map::revealTiles(Vector2 playerPos, float radius)
 {
+    TileRegion revealed = { 0, 0, 0, 0 };
+
     // Convert player world position to tile coordinates
     Vector2 centerTile = worldToTile({ playerPos.x - mLeftBoundary, playerPos.y - mTopBoundary });
     int centerX = (int)centerTile.x;
     int centerY = (int)centerTile.y;
 
+    // The revealed disc only changes when the player crosses a tile boundary
+    if (centerX == mLastRevealColumn && centerY == mLastRevealRow && radius == mLastRevealRadius)
+        return revealed;
+
+    mLastRevealColumn = centerX;
+    mLastRevealRow    = centerY;
+    mLastRevealRadius = radius;
+
     // Convert radius in world units to tile units
     float tileRadiusF = radius / mTileSize;
     int   tileRadius  = (int)ceilf(tileRadiusF);
+    float radiusSquared = tileRadiusF * tileRadiusF;
 
     // Bounds for square iteration
     int startX = std::max(0, centerX - tileRadius);
@@ -68,59 +214,190 @@ void Map::revealTiles(Vector2 playerPos, float radius)
     int startY = std::max(0, centerY - tileRadius);
     int endY   = std::min(mMapRows - 1, centerY + tileRadius);
 
+    std::vector<bool> &explored = *mTileExplored;
+
+    // Bounding box of newly explored tiles
+    int minX = mMapColumns, maxX = -1;
+    int minY = mMapRows,    maxY = -1;
+
     for (int y = startY; y <= endY; ++y)
     {
         for (int x = startX; x <= endX; ++x)
         {
             float dx = (float)(x - centerX);
             float dy = (float)(y - centerY);
-            float dist = sqrtf(dx*dx + dy*dy);
-            if (dist <= tileRadiusF)
-            {
-                int idx = getTileIndex(x, y);
-                if (idx >= 0 && idx < (int)mTileExplored.size())
-                    mTileExplored[idx] = true;
-            }
+            if (dx*dx + dy*dy > radiusSquared) continue;
+
+            int idx = getTileIndex(x, y);
+            if (explored[idx]) continue;
+
+            explored[idx]   = true;
+            mFogPixels[idx] = 255;
+
+            minX = std::min(minX, x); maxX = std::max(maxX, x);
+            minY = std::min(minY, y); maxY = std::max(maxY, y);
         }
     }
+
+    if (maxX < 0) return revealed;
+
+    revealed = { minX, minY, maxX - minX + 1, maxY - minY + 1 };
+
+    // Only the rows that changed reach the GPU
+    updateFogMask(minY, maxY);
+
+    return revealed;
+}
+
+void Map::attachExploredTiles(std::vector<bool> *tiles)
+{
+    mTileExplored = (tiles != nullptr) ? tiles : &mOwnedExplored;
+    mTileExplored->resize(mMapColumns * mMapRows, false);
+
+    refreshExploration();
+}
+
+void Map::setExploredTiles(const std::vector<bool>& data)
+{
+    *mTileExplored = data;
+    mTileExplored->resize(mMapColumns * mMapRows, false);
+
+    refreshExploration();
+}
+
+void Map::refreshExploration()
+{
+    const std::vector<bool> &explored = *mTileExplored;
+
+    for (int i = 0; i < (int)explored.size(); i++)
+        mFogPixels[i] = explored[i] ? 255 : 0;
+
+    updateFogMask(0, mMapRows - 1);
+
+    // The state may have changed underneath us, so the next reveal must run
+    mLastRevealColumn = -1;
+    mLastRevealRow    = -1;
+}
+
+void Map::loadFogMask()
+{
+    mFogPixels.assign(mMapColumns * mMapRows, 0);
+    for (int i = 0; i < (int)mTileExplored->size(); i++)
+        if ((*mTileExplored)[i]) mFogPixels[i] = 255;
+
+    Image fogImage = {
+        mFogPixels.data(),
+        mMapColumns,
+        mMapRows,
+        1,
+        PIXELFORMAT_UNCOMPRESSED_GRAYSCALE
+    };
+
+    // The image borrows mFogPixels, so it is uploaded but never unloaded
+    mFogMask = LoadTextureFromImage(fogImage);
+
+    // One texel per tile: keep hard tile edges and don't wrap at the borders
+    SetTextureFilter(mFogMask, TEXTURE_FILTER_POINT);
+    SetTextureWrap(mFogMask, TEXTURE_WRAP_CLAMP);
+}
+
+void Map::updateFogMask(int firstRow, int lastRow)
+{
+    if (mFogMask.id == 0) return;
+
+    // Rows are contiguous in mFogPixels, so a full-width band uploads in one call
+    Rectangle band = {
+        0.0f,
+        (float) firstRow,
+        (float) mMapColumns,
+        (float) (lastRow - firstRow + 1)
+    };
+
+    UpdateTextureRec(mFogMask, band, &mFogPixels[firstRow * mMapColumns]);
+}
+
+void Map::renderTile(int col, int row)
+{
+    // Get the tile index at the current row and column
+    int tile = mLevelData[row * mMapColumns + col];
+
+    // If the tile index is 0, we do not draw anything
+    if (tile == 0) return;
+
+    Rectangle destinationArea = {
+        mLeftBoundary + col * mTileSize,
+        mTopBoundary  + row * mTileSize, // y-axis is inverted
+        mTileSize,
+        mTileSize
+    };
+
+    // Draw the tile
+    DrawTexturePro(
+        mTextureAtlas,
+        mTextureAreas[tile - 1], // -1 because tile indices start at 1
+        destinationArea,
+        {0.0f, 0.0f}, // origin
+        0.0f,         // rotation
+        WHITE         // tint
+    );
 }
 
-void Map::render()
+void Map::render(const Camera2D *camera)
 {
-    // Draw each tile in the map
-    for (int row = 0; row < mMapRows; row++)
+    PROFILE_SCOPE(PROFILE_MAP_RENDER);
+
+    // Visible tile range (inclusive); without a camera every tile is visible
+    int firstCol = 0, lastCol = mMapColumns - 1;
+    int firstRow = 0, lastRow = mMapRows    - 1;
+
+    if (camera != nullptr)
     {
-        // Draw each column in the row
-        for (int col = 0; col < mMapColumns; col++)
-        {
-            // Get the tile index at the current row and column
-            int tile = mLevelData[row * mMapColumns + col];
+        Rectangle view = getCameraBounds(camera);
 
-            // If the tile index is 0, we do not draw anything
-            if (tile == 0) continue;
+        firstCol = std::max(firstCol, (int) floorf((view.x - mLeftBoundary) / mTileSize));
+        lastCol  = std::min(lastCol,  (int) floorf((view.x + view.width  - mLeftBoundary) / mTileSize));
+        firstRow = std::max(firstRow, (int) floorf((view.y - mTopBoundary) / mTileSize));
+        lastRow  = std::min(lastRow,  (int) floorf((view.y + view.height - mTopBoundary) / mTileSize));
 
-            Rectangle destinationArea = {
-                mLeftBoundary + col * mTileSize,
-                mTopBoundary  + row * mTileSize, // y-axis is inverted
-                mTileSize,
-                mTileSize
-            };
+        // Camera is looking entirely away from the map
+        if (firstCol > lastCol || firstRow > lastRow) return;
+    }
 
-            // Draw the tile
-            DrawTexturePro(
-                mTextureAtlas,
-                mTextureAreas[tile - 1], // -1 because tile indices start at 1
-                destinationArea,
-                {0.0f, 0.0f}, // origin
-                0.0f,         // rotation
-                WHITE         // tint
-            );
+    // Only visit the chunks that overlap the visible tile range
+    for (int chunkRow = firstRow / CHUNK_SIZE; chunkRow <= lastRow / CHUNK_SIZE; chunkRow++)
+    {
+        for (int chunkCol = firstCol / CHUNK_SIZE; chunkCol <= lastCol / CHUNK_SIZE; chunkCol++)
+        {
+            const MapChunk &chunk = mChunks[chunkRow * mChunkColumns + chunkCol];
+            if (chunk.isEmpty) continue;
 
-            // Fog overlay pass: draw dark mask over unexplored tiles
-            int idx = getTileIndex(col, row);
-            if (idx >= 0 && idx < (int)mTileExplored.size() && !mTileExplored[idx])
+            // Clip the chunk's tiles to the visible range
+            int startCol = std::max(firstCol, chunk.firstColumn);
+            int endCol   = std::min(lastCol,  chunk.firstColumn + chunk.columns - 1);
+            int startRow = std::max(firstRow, chunk.firstRow);
+            int endRow   = std::min(lastRow,  chunk.firstRow + chunk.rows - 1);
+
+            if (chunk.isDirty || chunk.cache.id == 0)
+            {
+                // Cache is stale (tiles edited since the last bake), so draw tile by tile
+                for (int row = startRow; row <= endRow; row++)
+                    for (int col = startCol; col <= endCol; col++)
+                        renderTile(col, row);
+            }
+            else
             {
-                DrawRectangleRec(destinationArea, Fade(BLACK, 0.75f));
+                // Render textures are stored upside down, hence the negative source height
+                Rectangle source = {
+                    0.0f, 0.0f,
+                    (float) chunk.cache.texture.width,
+                    (float) -chunk.cache.texture.height
+                };
+                Vector2 position = {
+                    mLeftBoundary + chunk.firstColumn * mTileSize,
+                    mTopBoundary  + chunk.firstRow    * mTileSize
+                };
+
+                DrawTextureRec(chunk.cache.texture, source, position, WHITE);
             }
         }
     }
@@ -159,39 +436,265 @@ bool Map::isSolidTileAt(Vector2 position, float *xOverlap, float *yOverlap)
     return true;
 }
 
-bool Map::hasLineOfSight(Vector2 start, Vector2 end)
+bool Map::isWallTile(int col, int row) const
+{
+    // Tiles outside the grid never block sight
+    if (col < 0 || col >= mMapColumns || row < 0 || row >= mMapRows) return false;
+
+    return mLevelData[row * mMapColumns + col] == 1; // 1 = Wall
+}
+
+bool Map::hasLineOfSight(Vector2 start, Vector2 end) const
 {
-    // Calculate direction and distance
-    Vector2 diff = Vector2Subtract(end, start);
-    float dist = Vector2Length(diff);
-    
     // If points are essentially the same, LOS is clear
-    if (dist < 1.0f) return true;
+    if (Vector2Distance(start, end) < 1.0f) return true;
+
+    // Grid traversal (Amanatides & Woo): walk the ray in tile units, visiting
+    // every tile it passes through exactly once, in order.
+    float startX = (start.x - mLeftBoundary) / mTileSize;
+    float startY = (start.y - mTopBoundary)  / mTileSize;
+    float deltaX = (end.x - mLeftBoundary) / mTileSize - startX;
+    float deltaY = (end.y - mTopBoundary)  / mTileSize - startY;
+
+    int tileX = (int) floorf(startX);
+    int tileY = (int) floorf(startY);
+    int endTileX = (int) floorf(startX + deltaX);
+    int endTileY = (int) floorf(startY + deltaY);
 
-    Vector2 dir = Vector2Normalize(diff);
+    int stepX = (deltaX > 0.0f) ? 1 : (deltaX < 0.0f ? -1 : 0);
+    int stepY = (deltaY > 0.0f) ? 1 : (deltaY < 0.0f ? -1 : 0);
 
-    float stepSize = mTileSize / 3.0f; 
-    
-    // Iterate from Start to End
-    for (float d = 0; d < dist; d += stepSize)
+    // Ray parameter t runs 0 -> 1 from start to end. tDelta is the t needed to
+    // cross one whole tile; tMax is the t at which the next tile edge is hit.
+    float tDeltaX = (stepX != 0) ? fabsf(1.0f / deltaX) : INFINITY;
+    float tDeltaY = (stepY != 0) ? fabsf(1.0f / deltaY) : INFINITY;
+
+    float tMaxX = (stepX > 0) ? (tileX + 1.0f - startX) * tDeltaX :
+                  (stepX < 0) ? (startX - tileX) * tDeltaX : INFINITY;
+    float tMaxY = (stepY > 0) ? (tileY + 1.0f - startY) * tDeltaY :
+                  (stepY < 0) ? (startY - tileY) * tDeltaY : INFINITY;
+
+    while (true)
     {
-        Vector2 checkPos = Vector2Add(start, Vector2Scale(dir, d));
+        if (isWallTile(tileX, tileY)) return false; // LOS Blocked
 
-        // Convert World Pos -> Map Grid Coordinates
-        int tx = floor((checkPos.x - mLeftBoundary) / mTileSize);
-        int ty = floor((checkPos.y - mTopBoundary) / mTileSize);
+        if (tileX == endTileX && tileY == endTileY) break;
 
-        // Check Bounds
-        if (tx >= 0 && tx < mMapColumns && ty >= 0 && ty < mMapRows)
+        // Step into whichever neighbouring tile the ray enters first, and stop
+        // once the next edge lies beyond the end point
+        if (tMaxX < tMaxY)
         {
-            // Check Collision
-            int tileID = mLevelData[ty * mMapColumns + tx];
-            if (tileID == 1) // 1 = Wall
-            {
-                return false; // LOS Blocked
-            }
+            if (tMaxX > 1.0f) break;
+            tileX += stepX;
+            tMaxX += tDeltaX;
+        }
+        else
+        {
+            if (tMaxY > 1.0f) break;
+            tileY += stepY;
+            tMaxY += tDeltaY;
         }
     }
 
     return true; // No walls hit
-}
\ No newline at end of file
+}
+
+// PATHFINDING
+
+void Map::buildWalkability()
+{
+    int tileCount = mMapColumns * mMapRows;
+
+    mWalkable.resize(tileCount);
+    for (int i = 0; i < tileCount; i++) mWalkable[i] = (mLevelData[i] != 1) ? 1 : 0; // 1 = Wall
+
+    mPathCost.assign(tileCount, 0);
+    mPathParent.assign(tileCount, -1);
+    mPathStamp.assign(tileCount, 0);
+    mFlowDistance.assign(tileCount, -1);
+    mFlowTarget = -1;
+    mNavVersion++;
+}
+
+bool Map::isWalkableTile(int col, int row) const
+{
+    if (col < 0 || col >= mMapColumns || row < 0 || row >= mMapRows) return false;
+
+    return mWalkable[row * mMapColumns + col] != 0;
+}
+
+bool Map::worldToCell(Vector2 position, int *col, int *row) const
+{
+    *col = (int) floorf((position.x - mLeftBoundary) / mTileSize);
+    *row = (int) floorf((position.y - mTopBoundary)  / mTileSize);
+
+    return *col >= 0 && *col < mMapColumns && *row >= 0 && *row < mMapRows;
+}
+
+Vector2 Map::cellCentre(int col, int row) const
+{
+    return {
+        mLeftBoundary + col * mTileSize + mTileSize / 2.0f,
+        mTopBoundary  + row * mTileSize + mTileSize / 2.0f
+    };
+}
+
+bool Map::findPath(Vector2 start, Vector2 goal, std::vector<Vector2> &waypoints)
+{
+    waypoints.clear();
+
+    int startCol, startRow, goalCol, goalRow;
+    if (!worldToCell(start, &startCol, &startRow)) return false;
+    if (!worldToCell(goal, &goalCol, &goalRow) || !isWalkableTile(goalCol, goalRow)) return false;
+
+    int startTile = startRow * mMapColumns + startCol;
+    int goalTile  = goalRow  * mMapColumns + goalCol;
+
+    // New stamp instead of clearing the scratch arrays
+    if (++mPathSearch == 0)
+    {
+        std::fill(mPathStamp.begin(), mPathStamp.end(), 0);
+        mPathSearch = 1;
+    }
+
+    auto estimate = [&](int tile)
+    {
+        return abs(tile % mMapColumns - goalCol) + abs(tile / mMapColumns - goalRow);
+    };
+    auto heapOrder = [](const std::pair<int, int> &a, const std::pair<int, int> &b)
+    {
+        return a.first > b.first;
+    };
+
+    // The start tile may overlap a wall (agents are pushed out of walls
+    // after moving), so it is allowed regardless of walkability
+    mOpenList.clear();
+    mPathStamp[startTile]  = mPathSearch;
+    mPathCost[startTile]   = 0;
+    mPathParent[startTile] = -1;
+    mOpenList.push_back({ estimate(startTile), startTile });
+
+    const int stepCol[4] = { 1, -1, 0,  0 };
+    const int stepRow[4] = { 0,  0, 1, -1 };
+
+    bool found = false;
+    while (!mOpenList.empty())
+    {
+        std::pop_heap(mOpenList.begin(), mOpenList.end(), heapOrder);
+        std::pair<int, int> next = mOpenList.back();
+        mOpenList.pop_back();
+
+        int tile = next.second;
+        if (tile == goalTile) { found = true; break; }
+
+        // Skip stale heap entries for tiles already reached more cheaply
+        if (next.first > mPathCost[tile] + estimate(tile)) continue;
+
+        int col = tile % mMapColumns;
+        int row = tile / mMapColumns;
+        for (int i = 0; i < 4; i++)
+        {
+            int nextCol = col + stepCol[i];
+            int nextRow = row + stepRow[i];
+            if (!isWalkableTile(nextCol, nextRow)) continue;
+
+            int neighbour = nextRow * mMapColumns + nextCol;
+            int cost = mPathCost[tile] + 1;
+            if (mPathStamp[neighbour] == mPathSearch && mPathCost[neighbour] <= cost) continue;
+
+            mPathStamp[neighbour]  = mPathSearch;
+            mPathCost[neighbour]   = cost;
+            mPathParent[neighbour] = tile;
+            mOpenList.push_back({ cost + estimate(neighbour), neighbour });
+            std::push_heap(mOpenList.begin(), mOpenList.end(), heapOrder);
+        }
+    }
+
+    if (!found) return false;
+
+    // Walk back from the goal; the last waypoint is the goal point itself
+    waypoints.push_back(goal);
+    for (int tile = mPathParent[goalTile]; tile != -1 && tile != startTile; tile = mPathParent[tile])
+        waypoints.push_back(cellCentre(tile % mMapColumns, tile / mMapColumns));
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    return true;
+}
+
+void Map::refreshFlowField(int targetTile)
+{
+    if (targetTile == mFlowTarget && mFlowVersion == mNavVersion) return;
+
+    mFlowTarget  = targetTile;
+    mFlowVersion = mNavVersion;
+
+    // Breadth-first from the target: every step costs the same
+    std::fill(mFlowDistance.begin(), mFlowDistance.end(), -1);
+    mFlowQueue.clear();
+    mFlowDistance[targetTile] = 0;
+    mFlowQueue.push_back(targetTile);
+
+    const int stepCol[4] = { 1, -1, 0,  0 };
+    const int stepRow[4] = { 0,  0, 1, -1 };
+
+    for (size_t head = 0; head < mFlowQueue.size(); head++)
+    {
+        int tile = mFlowQueue[head];
+        int col  = tile % mMapColumns;
+        int row  = tile / mMapColumns;
+
+        for (int i = 0; i < 4; i++)
+        {
+            int nextCol = col + stepCol[i];
+            int nextRow = row + stepRow[i];
+            if (!isWalkableTile(nextCol, nextRow)) continue;
+
+            int neighbour = nextRow * mMapColumns + nextCol;
+            if (mFlowDistance[neighbour] != -1) continue;
+
+            mFlowDistance[neighbour] = mFlowDistance[tile] + 1;
+            mFlowQueue.push_back(neighbour);
+        }
+    }
+}
+
+Vector2 Map::getFlowDirection(Vector2 position, Vector2 target)
+{
+    int col, row, targetCol, targetRow;
+    if (!worldToCell(position, &col, &row)) return { 0.0f, 0.0f };
+    if (!worldToCell(target, &targetCol, &targetRow) || !isWalkableTile(targetCol, targetRow))
+        return { 0.0f, 0.0f };
+
+    refreshFlowField(targetRow * mMapColumns + targetCol);
+
+    // Step to the neighbour closest to the target. From a tile the field
+    // does not reach (e.g. pushed into a wall) any reachable neighbour will do.
+    int bestDistance = mFlowDistance[row * mMapColumns + col];
+    if (bestDistance == 0) return { 0.0f, 0.0f };
+    if (bestDistance == -1) bestDistance = mMapColumns * mMapRows;
+
+    const int stepCol[4] = { 1, -1, 0,  0 };
+    const int stepRow[4] = { 0,  0, 1, -1 };
+
+    int bestCol = -1, bestRow = -1;
+    for (int i = 0; i < 4; i++)
+    {
+        int nextCol = col + stepCol[i];
+        int nextRow = row + stepRow[i];
+        if (!isWalkableTile(nextCol, nextRow)) continue;
+
+        int distance = mFlowDistance[nextRow * mMapColumns + nextCol];
+        if (distance == -1 || distance >= bestDistance) continue;
+
+        bestDistance = distance;
+        bestCol = nextCol;
+        bestRow = nextRow;
+    }
+
+    if (bestCol == -1) return { 0.0f, 0.0f };
+
+    Vector2 direction = Vector2Subtract(cellCentre(bestCol, bestRow), position);
+    if (Vector2Length(direction) <= 0.0f) return { 0.0f, 0.0f };
+
+    return Vector2Normalize(direction);
+}
@@ -1,8 +1,33 @@
 #include "cs3113.h"
+#include "AssetCache.h"
 
 #ifndef MAP_H
 #define MAP_H
 
+// A square block of tiles that is culled against the camera as a unit
+struct MapChunk
+{
+    int firstColumn; // first tile column covered by this chunk
+    int firstRow;    // first tile row covered by this chunk
+    int columns;     // columns in this chunk (smaller at the map's edge)
+    int rows;        // rows in this chunk (smaller at the map's edge)
+    bool isEmpty;    // true if every tile in the chunk is 0 (nothing to draw)
+    bool isDirty;    // tiles changed since the cache was last baked
+
+    RenderTexture2D cache; // pre-rendered tile layer (id 0 when not baked)
+};
+
+// Rectangle of tiles in map grid coordinates (columns == 0 means empty)
+struct TileRegion
+{
+    int column;
+    int row;
+    int columns;
+    int rows;
+
+    bool isEmpty() const { return columns <= 0 || rows <= 0; }
+};
+
 class Map
 {
 private:
@@ -25,30 +50,106 @@ private:
     float mTopBoundary;   // top boundary of the map in world coordinates
     float mBottomBoundary;// bottom boundary of the map in world coordinates
 
-    // Tracks which tiles have been explored/seen by the player
-    std::vector<bool> mTileExplored;
+    // Tracks which tiles have been explored/seen by the player. Points at
+    // mOwnedExplored unless a scene attaches its own persistent buffer.
+    std::vector<bool> *mTileExplored;
+    std::vector<bool>  mOwnedExplored;
+
+    // Last reveal centre (in tiles) and radius, to skip repeated reveals
+    int   mLastRevealColumn = -1;
+    int   mLastRevealRow    = -1;
+    float mLastRevealRadius = 0.0f;
+
+    // GPU mirror of mTileExplored (one byte per tile, 255 = explored) that
+    // the fragment shader samples to darken unexplored areas
+    std::vector<unsigned char> mFogPixels;
+    Texture2D mFogMask;
+
+    // Chunk grid used to cull rendering to the camera's view
+    std::vector<MapChunk> mChunks;
+    int mChunkColumns; // number of chunks across
+    int mChunkRows;    // number of chunks down
+
+    // Navigation grid: 1 for tiles agents may stand on (anything but walls).
+    // mNavVersion changes whenever it does, so cached paths can tell.
+    std::vector<unsigned char> mWalkable;
+    unsigned int mNavVersion = 0;
+
+    // A* scratch space, reused between searches. A tile's cost/parent are
+    // only valid when its stamp matches the current search.
+    std::vector<int>                 mPathCost;
+    std::vector<int>                 mPathParent;
+    std::vector<unsigned int>        mPathStamp;
+    std::vector<std::pair<int, int>> mOpenList; // (estimated total, tile) min-heap
+    unsigned int                     mPathSearch = 0;
+
+    // Flow field toward one target tile: steps from each tile to the target
+    // (-1 = unreachable). Shared by every pursuer and only rebuilt when the
+    // target moves to another tile or the grid changes.
+    std::vector<int> mFlowDistance;
+    std::vector<int> mFlowQueue;
+    int              mFlowTarget  = -1;
+    unsigned int     mFlowVersion = 0;
+
+    void buildChunks();
+    bool isChunkEmpty(const MapChunk &chunk) const;
+    void unloadChunks();
+    void bakeChunk(MapChunk &chunk);
+    void renderTile(int col, int row);
+    void loadFogMask();
+    void updateFogMask(int firstRow, int lastRow);
+    void refreshExploration();
+    void buildWalkability();
+    bool worldToCell(Vector2 position, int *col, int *row) const;
+    Vector2 cellCentre(int col, int row) const;
+    void refreshFlowField(int targetTile);
 
 public:
+    static constexpr int CHUNK_SIZE = 16; // tiles along each edge of a chunk
+
     Map(int mapColumns, int mapRows, unsigned int *levelData,
         const char *textureFilePath, float tileSize, int textureColumns,
         int textureRows, Vector2 origin);
     ~Map();
 
     void build();
-    void render();
+    void render(const Camera2D *camera = nullptr); // nullptr draws the whole map
+    // Tile edits mark their chunk dirty; bakeDirtyChunks() must be called
+    // outside of BeginDrawing()/BeginMode2D() to refresh the cached layer
+    void setTile(int col, int row, unsigned int tile);
+    void bakeDirtyChunks();
+
     bool isSolidTileAt(Vector2 position, float *xOverlap, float *yOverlap);
-    bool hasLineOfSight(Vector2 start, Vector2 end);
+    bool isWallTile(int col, int row) const;
+    bool hasLineOfSight(Vector2 start, Vector2 end) const;
+
+    // Pathfinding over 4-connected walkable tiles
+    bool isWalkableTile(int col, int row) const;
+    // A* from start to goal. On success, waypoints holds the centres of the
+    // tiles to walk through after start's tile, ending with goal itself.
+    bool findPath(Vector2 start, Vector2 goal, std::vector<Vector2> &waypoints);
+    // Unit vector from position toward the next tile on the shortest route
+    // to target, from the shared flow field. {0, 0} when target is
+    // unreachable or already in the same tile.
+    Vector2 getFlowDirection(Vector2 position, Vector2 target);
+    unsigned int getNavVersion() const { return mNavVersion; }
 
     // Helpers for coordinate conversion and indexing
     int getTileIndex(int x, int y);
     Vector2 worldToTile(Vector2 pos);
 
-    // Reveal tiles around player within radius
-    void revealTiles(Vector2 playerPos, float radius);
+    // Reveal tiles around player within radius. Returns the region of tiles
+    // that became explored (empty if the player hasn't changed tile).
+    TileRegion revealTiles(Vector2 playerPos, float radius);
+
+    // Exploration state. Scenes attach the buffer they persist in GameState so
+    // the map writes into it directly; nullptr reverts to the map's own buffer.
+    void attachExploredTiles(std::vector<bool> *tiles);
+    std::vector<bool>& getExploredTiles() { return *mTileExplored; }
+    void setExploredTiles(const std::vector<bool>& data);
 
-    // Accessor/mutator for exploration state so scenes can persist it
-    std::vector<bool>& getExploredTiles() { return mTileExplored; }
-    void setExploredTiles(const std::vector<bool>& data) { mTileExplored = data; }
+    // Fog-of-war mask covering the map bounds, one texel per tile
+    Texture2D getFogMask() const { return mFogMask; }
 
     int           getMapColumns()     const { return mMapColumns;     };
     int           getMapRows()        const { return mMapRows;        };
@@ -0,0 +1,382 @@
+#include "NullBackend.h"
+#include <stdarg.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <set>
+
+// Stand-ins for the raylib functions the game calls, for the headless build
+// (see NullBackend.h). Nothing here touches a window, GPU or audio device.
+
+// VIRTUAL CLOCK & HANDLES
+static double   gVirtualTime = 0.0;
+static long long gTickCount  = 0;
+static unsigned int gNextHandle = 1; // fake GL ids / audio contexts
+static unsigned int gRandomState = 0x2545F491u;
+
+static void *nextFakePointer() { return (void *)(uintptr_t)(gNextHandle++); }
+
+// SCRIPTED INPUT
+struct InputStep
+{
+    int ticks;
+    std::set<int> keys;
+};
+
+static std::vector<InputStep> gInputScript;
+static int gStepIndex = 0;      // current step
+static int gStepTicksLeft = 0;  // ticks left in it
+static std::set<int> gKeysDown;
+static std::set<int> gKeysDownBefore; // previous tick, for pressed/released
+
+static const struct { const char *name; int key; } KEY_NAMES[] = {
+    { "SPACE", KEY_SPACE }, { "ENTER", KEY_ENTER }, { "ESCAPE", KEY_ESCAPE },
+    { "UP", KEY_UP }, { "DOWN", KEY_DOWN }, { "LEFT", KEY_LEFT }, { "RIGHT", KEY_RIGHT },
+    { "W", KEY_W }, { "A", KEY_A }, { "S", KEY_S }, { "D", KEY_D },
+    { "C", KEY_C }, { "P", KEY_P }, { "R", KEY_R }, { "Y", KEY_Y }, { "Z", KEY_Z },
+    { "F1", KEY_F1 }, { "F2", KEY_F2 }, { "F3", KEY_F3 }, { "F4", KEY_F4 }
+};
+
+static int keyFromName(const std::string &name)
+{
+    for (const auto &entry : KEY_NAMES)
+        if (name == entry.name) return entry.key;
+    return -1;
+}
+
+bool headlessLoadInput(const char *script)
+{
+    std::vector<InputStep> steps;
+    std::string text = script ? script : "";
+    size_t start = 0;
+
+    while (start <= text.size())
+    {
+        size_t end = text.find_first_of(";\n", start);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(start, end - start);
+        start = end + 1;
+
+        // Tokenise on whitespace; blank steps are skipped
+        std::vector<std::string> tokens;
+        size_t i = 0;
+        while (i < line.size())
+        {
+            while (i < line.size() && isspace((unsigned char) line[i])) i++;
+            size_t j = i;
+            while (j < line.size() && !isspace((unsigned char) line[j])) j++;
+            if (j > i) tokens.push_back(line.substr(i, j - i));
+            i = j;
+        }
+        if (tokens.empty()) continue;
+
+        InputStep step;
+        step.ticks = atoi(tokens[0].c_str());
+        if (step.ticks <= 0 || tokens.size() < 2)
+        {
+            printf("NullBackend: bad input step '%s'\n", line.c_str());
+            return false;
+        }
+        for (size_t k = 1; k < tokens.size(); k++)
+        {
+            if (tokens[k] == "-") continue;
+            int key = keyFromName(tokens[k]);
+            if (key < 0)
+            {
+                printf("NullBackend: unknown key '%s'\n", tokens[k].c_str());
+                return false;
+            }
+            step.keys.insert(key);
+        }
+        steps.push_back(step);
+    }
+
+    gInputScript   = steps;
+    gStepIndex     = 0;
+    gStepTicksLeft = gInputScript.empty() ? 0 : gInputScript[0].ticks;
+    return true;
+}
+
+void headlessStep(float deltaTime)
+{
+    gVirtualTime += deltaTime;
+    gTickCount++;
+
+    gKeysDownBefore = gKeysDown;
+    if (gInputScript.empty()) { gKeysDown.clear(); return; }
+
+    if (gStepTicksLeft <= 0)
+    {
+        gStepIndex     = (gStepIndex + 1) % (int) gInputScript.size();
+        gStepTicksLeft = gInputScript[gStepIndex].ticks;
+    }
+    gKeysDown = gInputScript[gStepIndex].keys;
+    gStepTicksLeft--;
+}
+
+long long headlessGetTicks() { return gTickCount; }
+
+// WINDOW & TIMING
+void InitWindow(int width, int height, const char *title) { }
+void CloseWindow(void) { }
+bool WindowShouldClose(void) { return false; }
+bool IsWindowReady(void) { return true; }
+void SetConfigFlags(unsigned int flags) { }
+void SetTargetFPS(int fps) { }
+float GetFrameTime(void) { return 1.0f / 60.0f; }
+double GetTime(void) { return gVirtualTime; }
+int GetFPS(void) { return 60; }
+int GetScreenWidth(void) { return 1000; }
+int GetScreenHeight(void) { return 600; }
+void SetExitKey(int key) { }
+
+// DRAWING
+void ClearBackground(Color color) { }
+void BeginDrawing(void) { }
+void EndDrawing(void) { }
+void BeginMode2D(Camera2D camera) { }
+void EndMode2D(void) { }
+void BeginTextureMode(RenderTexture2D target) { }
+void EndTextureMode(void) { }
+void BeginShaderMode(Shader shader) { }
+void EndShaderMode(void) { }
+void BeginBlendMode(int mode) { }
+void EndBlendMode(void) { }
+
+void DrawPixel(int posX, int posY, Color color) { }
+void DrawLine(int startPosX, int startPosY, int endPosX, int endPosY, Color color) { }
+void DrawLineV(Vector2 startPos, Vector2 endPos, Color color) { }
+void DrawCircle(int centerX, int centerY, float radius, Color color) { }
+void DrawCircleV(Vector2 center, float radius, Color color) { }
+void DrawCircleSector(Vector2 center, float radius, float startAngle, float endAngle, int segments, Color color) { }
+void DrawRectangle(int posX, int posY, int width, int height, Color color) { }
+void DrawRectangleV(Vector2 position, Vector2 size, Color color) { }
+void DrawRectangleRec(Rectangle rec, Color color) { }
+void DrawRectangleLines(int posX, int posY, int width, int height, Color color) { }
+void DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color) { }
+void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) { }
+void DrawTexture(Texture2D texture, int posX, int posY, Color tint) { }
+void DrawTextureV(Texture2D texture, Vector2 position, Color tint) { }
+void DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint) { }
+void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint) { }
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) { }
+void DrawFPS(int posX, int posY) { }
+void DrawText(const char *text, int posX, int posY, int fontSize, Color color) { }
+
+// Same rough metric as raylib's default font, so layout code stays sane
+int MeasureText(const char *text, int fontSize)
+{
+    return text ? (int) strlen(text) * fontSize / 2 : 0;
+}
+
+const char *TextFormat(const char *text, ...)
+{
+    // raylib also rotates a few static buffers so nested calls stay valid
+    static char buffers[4][1024];
+    static int  index = 0;
+    char *buffer = buffers[index];
+    index = (index + 1) % 4;
+
+    va_list args;
+    va_start(args, text);
+    vsnprintf(buffer, sizeof(buffers[0]), text, args);
+    va_end(args);
+    return buffer;
+}
+
+Color Fade(Color color, float alpha)
+{
+    if (alpha < 0.0f) alpha = 0.0f;
+    if (alpha > 1.0f) alpha = 1.0f;
+    color.a = (unsigned char)(255.0f * alpha);
+    return color;
+}
+
+// SHADERS
+Shader LoadShader(const char *vsFileName, const char *fsFileName)
+{
+    Shader shader = {};
+    shader.id = gNextHandle++;
+    return shader;
+}
+bool IsShaderReady(Shader shader) { return shader.id != 0; }
+int GetShaderLocation(Shader shader, const char *uniformName) { return -1; }
+void SetShaderValue(Shader shader, int locIndex, const void *value, int uniformType) { }
+void SetShaderValueTexture(Shader shader, int locIndex, Texture2D texture) { }
+void UnloadShader(Shader shader) { }
+
+// CAMERA
+Vector2 GetScreenToWorld2D(Vector2 position, Camera2D camera)
+{
+    float zoom = camera.zoom != 0.0f ? camera.zoom : 1.0f;
+    return { (position.x - camera.offset.x) / zoom + camera.target.x,
+             (position.y - camera.offset.y) / zoom + camera.target.y };
+}
+
+Vector2 GetWorldToScreen2D(Vector2 position, Camera2D camera)
+{
+    return { (position.x - camera.target.x) * camera.zoom + camera.offset.x,
+             (position.y - camera.target.y) * camera.zoom + camera.offset.y };
+}
+
+// RANDOM & LOGGING
+void SetRandomSeed(unsigned int seed) { gRandomState = seed ? seed : 0x2545F491u; }
+
+int GetRandomValue(int min, int max)
+{
+    if (min > max) { int t = min; min = max; max = t; }
+
+    // xorshift32: deterministic for a given seed, on every platform
+    gRandomState ^= gRandomState << 13;
+    gRandomState ^= gRandomState >> 17;
+    gRandomState ^= gRandomState << 5;
+    return min + (int)(gRandomState % (unsigned int)(max - min + 1));
+}
+
+void TraceLog(int logLevel, const char *text, ...) { }
+void SetTraceLogLevel(int logLevel) { }
+
+// FILES (real file system; assets are never decoded)
+unsigned char *LoadFileData(const char *fileName, int *dataSize)
+{
+    if (dataSize) *dataSize = 0;
+    return nullptr;
+}
+void UnloadFileData(unsigned char *data) { free(data); }
+bool SaveFileData(const char *fileName, void *data, int dataSize)
+{
+    FILE *file = fopen(fileName, "wb");
+    if (!file) return false;
+    bool ok = fwrite(data, 1, dataSize, file) == (size_t) dataSize;
+    fclose(file);
+    return ok;
+}
+bool FileExists(const char *fileName)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (!file) return false;
+    fclose(file);
+    return true;
+}
+const char *GetFileExtension(const char *fileName)
+{
+    const char *dot = fileName ? strrchr(fileName, '.') : nullptr;
+    return dot;
+}
+long GetFileModTime(const char *fileName) { return 0; }
+
+// INPUT
+bool IsKeyPressed(int key)  { return gKeysDown.count(key) && !gKeysDownBefore.count(key); }
+bool IsKeyDown(int key)     { return gKeysDown.count(key) != 0; }
+bool IsKeyReleased(int key) { return !gKeysDown.count(key) && gKeysDownBefore.count(key); }
+bool IsKeyUp(int key)       { return gKeysDown.count(key) == 0; }
+
+// COLLISION
+bool CheckCollisionRecs(Rectangle rec1, Rectangle rec2)
+{
+    return rec1.x < rec2.x + rec2.width  && rec1.x + rec1.width  > rec2.x &&
+           rec1.y < rec2.y + rec2.height && rec1.y + rec1.height > rec2.y;
+}
+
+Rectangle GetCollisionRec(Rectangle rec1, Rectangle rec2)
+{
+    if (!CheckCollisionRecs(rec1, rec2)) return { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    float left   = fmaxf(rec1.x, rec2.x);
+    float top    = fmaxf(rec1.y, rec2.y);
+    float right  = fminf(rec1.x + rec1.width,  rec2.x + rec2.width);
+    float bottom = fminf(rec1.y + rec1.height, rec2.y + rec2.height);
+    return { left, top, right - left, bottom - top };
+}
+
+// IMAGES & TEXTURES (handles only; sizes are kept so UV maths still works)
+Image LoadImage(const char *fileName) { return {}; }
+Image LoadImageFromMemory(const char *fileType, const unsigned char *fileData, int dataSize) { return {}; }
+bool IsImageReady(Image image) { return image.data != nullptr; }
+void UnloadImage(Image image) { }
+Image GenImageColor(int width, int height, Color color)
+{
+    Image image = {};
+    image.width   = width;
+    image.height  = height;
+    image.mipmaps = 1;
+    image.format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return image;
+}
+
+static Texture2D fakeTexture(int width, int height)
+{
+    Texture2D texture = {};
+    texture.id      = gNextHandle++;
+    texture.width   = width;
+    texture.height  = height;
+    texture.mipmaps = 1;
+    texture.format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return texture;
+}
+
+Texture2D LoadTexture(const char *fileName) { return fakeTexture(64, 64); }
+Texture2D LoadTextureFromImage(Image image)
+{
+    return fakeTexture(image.width > 0 ? image.width : 64, image.height > 0 ? image.height : 64);
+}
+RenderTexture2D LoadRenderTexture(int width, int height)
+{
+    RenderTexture2D target = {};
+    target.id      = gNextHandle++;
+    target.texture = fakeTexture(width, height);
+    return target;
+}
+bool IsTextureReady(Texture2D texture) { return texture.id != 0; }
+void UnloadTexture(Texture2D texture) { }
+bool IsRenderTextureReady(RenderTexture2D target) { return target.id != 0; }
+void UnloadRenderTexture(RenderTexture2D target) { }
+void UpdateTexture(Texture2D texture, const void *pixels) { }
+void UpdateTextureRec(Texture2D texture, Rectangle rec, const void *pixels) { }
+void SetTextureFilter(Texture2D texture, int filter) { }
+void SetTextureWrap(Texture2D texture, int wrap) { }
+
+// AUDIO (handles are unique so the asset cache can still key on them)
+void InitAudioDevice(void) { }
+void CloseAudioDevice(void) { }
+bool IsAudioDeviceReady(void) { return true; }
+void SetMasterVolume(float volume) { }
+
+Wave LoadWave(const char *fileName) { return {}; }
+Wave LoadWaveFromMemory(const char *fileType, const unsigned char *fileData, int dataSize) { return {}; }
+Sound LoadSound(const char *fileName)
+{
+    Sound sound = {};
+    sound.stream.buffer = (rAudioBuffer *) nextFakePointer();
+    sound.frameCount    = 1;
+    return sound;
+}
+Sound LoadSoundFromWave(Wave wave) { return LoadSound(nullptr); }
+void UnloadWave(Wave wave) { }
+void UnloadSound(Sound sound) { }
+void PlaySound(Sound sound) { }
+void StopSound(Sound sound) { }
+void SetSoundVolume(Sound sound, float volume) { }
+
+Music LoadMusicStream(const char *fileName)
+{
+    Music music = {};
+    music.ctxData    = nextFakePointer();
+    music.frameCount = 1;
+    music.looping    = true;
+    return music;
+}
+Music LoadMusicStreamFromMemory(const char *fileType, const unsigned char *data, int dataSize)
+{
+    return LoadMusicStream(nullptr);
+}
+void UnloadMusicStream(Music music) { }
+void PlayMusicStream(Music music) { }
+bool IsMusicStreamPlaying(Music music) { return false; }
+void UpdateMusicStream(Music music) { }
+void StopMusicStream(Music music) { }
+void PauseMusicStream(Music music) { }
+void ResumeMusicStream(Music music) { }
+void SeekMusicStream(Music music, float position) { }
+void SetMusicVolume(Music music, float volume) { }
@@ -0,0 +1,24 @@
+#include "cs3113.h"
+
+#ifndef NULL_BACKEND_H
+#define NULL_BACKEND_H
+
+// Controls for the null raylib backend (lib/NullBackend.cpp), which the
+// headless build links instead of raylib. Drawing and audio calls do
+// nothing, loaders hand out fake handles, GetTime() is a virtual clock and
+// keyboard queries read a scripted input track.
+
+// Input script: steps separated by ';' or newlines, each "<ticks> <KEY>..."
+// holding those keys for that many ticks ("-" holds nothing), e.g.
+// "30 RIGHT; 1 SPACE; 1 -". The script loops. Returns false (and keeps the
+// previous script) if a step cannot be parsed.
+bool headlessLoadInput(const char *script);
+
+// Advances the virtual clock by deltaTime and the input track by one tick.
+// Call once before each scene update().
+void headlessStep(float deltaTime);
+
+// Ticks stepped since start-up
+long long headlessGetTicks();
+
+#endif // NULL_BACKEND_H
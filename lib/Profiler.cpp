@@ -0,0 +1,211 @@
+#include "Profiler.h"
+#include <algorithm>
+
+Profiler gProfiler;
+
+static const char *ZONE_NAMES[PROFILE_ZONE_COUNT] = {
+    "frame", "update", "scene update", "ai", "collision", "audio",
+    "render", "map render", "entity render", "hud"
+};
+
+// Indentation in the overlay, following how the zones nest
+static const int ZONE_DEPTH[PROFILE_ZONE_COUNT] = { 0, 1, 2, 3, 3, 1, 1, 2, 2, 2 };
+
+constexpr float FRAME_BUDGET_MS = 1000.0f / 60.0f;
+
+Profiler::Profiler() : mEpoch {Clock::now()}, mFrameStart {mEpoch}
+{
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++) mCurrent[z] = 0.0;
+    mTrace = new TraceEvent[TRACE_CAPACITY];
+}
+
+Profiler::~Profiler() { delete[] mTrace; }
+
+const char *Profiler::getZoneName(ProfileZone zone)
+{
+    return (zone >= 0 && zone < PROFILE_ZONE_COUNT) ? ZONE_NAMES[zone] : "?";
+}
+
+void Profiler::beginFrame()
+{
+    if (!mEnabled) return;
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++) mCurrent[z] = 0.0;
+    mFrameStart = Clock::now();
+}
+
+void Profiler::endFrame()
+{
+    if (!mEnabled) return;
+    record(PROFILE_FRAME, mFrameStart, Clock::now());
+
+    float *frame = mHistory[mFrameCount % HISTORY_FRAMES];
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++) frame[z] = (float)(mCurrent[z] / 1000.0);
+    mFrameCount++;
+}
+
+void Profiler::record(ProfileZone zone, Clock::time_point start, Clock::time_point end)
+{
+    if (!mEnabled) return;
+
+    long long startMicroseconds    = std::chrono::duration_cast<std::chrono::microseconds>(start - mEpoch).count();
+    long long durationMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    // Sub-microsecond sections still count toward the frame total
+    mCurrent[zone] += std::chrono::duration<double, std::micro>(end - start).count();
+
+    TraceEvent &event = mTrace[mTraceCount % TRACE_CAPACITY];
+    event.zone                 = (uint8_t) zone;
+    event.startMicroseconds    = startMicroseconds;
+    event.durationMicroseconds = (int32_t) durationMicroseconds;
+    mTraceCount++;
+}
+
+int Profiler::getHistoryCount() const
+{
+    return (int) std::min<long long>(mFrameCount, HISTORY_FRAMES);
+}
+
+const float *Profiler::getHistoryFrame(int age) const
+{
+    return mHistory[(mFrameCount - 1 - age) % HISTORY_FRAMES];
+}
+
+Profiler::Stats Profiler::getStats(ProfileZone zone) const
+{
+    Stats stats = { 0.0f, 0.0f, 0.0f };
+    int count = getHistoryCount();
+    if (count == 0) return stats;
+
+    float samples[HISTORY_FRAMES];
+    float sum = 0.0f;
+    for (int i = 0; i < count; i++)
+    {
+        samples[i] = getHistoryFrame(i)[zone];
+        sum += samples[i];
+    }
+
+    // Nearest-rank 99th percentile
+    int rank = (int)(0.99f * (count - 1) + 0.5f);
+    std::nth_element(samples, samples + rank, samples + count);
+    stats.p99 = samples[rank];
+    stats.min = *std::min_element(samples, samples + count);
+    stats.avg = sum / count;
+    return stats;
+}
+
+void Profiler::drawOverlay(int x, int y) const
+{
+    if (!mOverlayVisible) return;
+
+    constexpr int GRAPH_FRAMES = 120;
+    constexpr int ROW_HEIGHT   = 20;
+    constexpr int NAME_WIDTH   = 130;
+    constexpr int STATS_WIDTH  = 200;
+    constexpr int FONT_SIZE    = 10;
+    const int width  = NAME_WIDTH + STATS_WIDTH + GRAPH_FRAMES + 20;
+    const int height = (PROFILE_ZONE_COUNT + 1) * ROW_HEIGHT + 10;
+
+    DrawRectangle(x, y, width, height, Fade(BLACK, 0.75f));
+    DrawText(TextFormat("PROFILER  %d frames   min / avg / p99 ms   [F4] dump", getHistoryCount()),
+        x + 8, y + 6, FONT_SIZE, YELLOW);
+
+    int count  = getHistoryCount();
+    int graphX = x + 10 + NAME_WIDTH + STATS_WIDTH;
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++)
+    {
+        int rowY = y + 6 + (z + 1) * ROW_HEIGHT;
+        Stats stats = getStats((ProfileZone) z);
+
+        DrawText(ZONE_NAMES[z], x + 8 + ZONE_DEPTH[z] * 10, rowY, FONT_SIZE, LIGHTGRAY);
+        DrawText(TextFormat("%6.2f %6.2f %6.2f", stats.min, stats.avg, stats.p99),
+            x + 8 + NAME_WIDTH, rowY, FONT_SIZE, WHITE);
+
+        // Newest frame on the right; the frame row is scaled to the 60 Hz
+        // budget, the others to their own worst frame
+        float scale = (z == PROFILE_FRAME) ? FRAME_BUDGET_MS * 1.5f : 0.0f;
+        for (int i = 0; i < count && i < GRAPH_FRAMES; i++) scale = std::max(scale, getHistoryFrame(i)[z]);
+        if (scale <= 0.0f) continue;
+
+        const int graphHeight = ROW_HEIGHT - 6;
+        DrawRectangle(graphX, rowY, GRAPH_FRAMES, graphHeight, Fade(DARKGRAY, 0.5f));
+        for (int i = 0; i < count && i < GRAPH_FRAMES; i++)
+        {
+            float ms = getHistoryFrame(i)[z];
+            int barHeight = (int)(graphHeight * ms / scale + 0.5f);
+            if (barHeight <= 0) continue;
+
+            Color color = (ms > FRAME_BUDGET_MS) ? RED : (z == PROFILE_FRAME ? GREEN : SKYBLUE);
+            DrawRectangle(graphX + GRAPH_FRAMES - 1 - i, rowY + graphHeight - barHeight, 1, barHeight, color);
+        }
+        if (z == PROFILE_FRAME)
+        {
+            int budgetY = rowY + graphHeight - (int)(graphHeight * FRAME_BUDGET_MS / scale);
+            DrawLine(graphX, budgetY, graphX + GRAPH_FRAMES, budgetY, YELLOW);
+        }
+    }
+}
+
+bool Profiler::dumpCsv(const char *filePath) const
+{
+    FILE *file = fopen(filePath, "w");
+    if (!file)
+    {
+        printf("Profiler: cannot write '%s'\n", filePath);
+        return false;
+    }
+
+    fprintf(file, "frame");
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++) fprintf(file, ",%s_ms", ZONE_NAMES[z]);
+    fprintf(file, "\n");
+
+    // Oldest first
+    int count = getHistoryCount();
+    for (int age = count - 1; age >= 0; age--)
+    {
+        const float *frame = getHistoryFrame(age);
+        fprintf(file, "%lld", mFrameCount - 1 - age);
+        for (int z = 0; z < PROFILE_ZONE_COUNT; z++) fprintf(file, ",%.4f", frame[z]);
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    printf("Profiler: wrote %d frames to %s\n", count, filePath);
+    return true;
+}
+
+bool Profiler::dumpChromeTrace(const char *filePath) const
+{
+    FILE *file = fopen(filePath, "w");
+    if (!file)
+    {
+        printf("Profiler: cannot write '%s'\n", filePath);
+        return false;
+    }
+
+    // Complete ("X") events on one thread; the viewer nests them by time
+    long long count = std::min<long long>(mTraceCount, TRACE_CAPACITY);
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (long long n = mTraceCount - count; n < mTraceCount; n++)
+    {
+        const TraceEvent &event = mTrace[n % TRACE_CAPACITY];
+        fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%lld,\"dur\":%d}%s\n",
+            ZONE_NAMES[event.zone], (long long) event.startMicroseconds, (int) event.durationMicroseconds,
+            n + 1 < mTraceCount ? "," : "");
+    }
+    fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+
+    fclose(file);
+    printf("Profiler: wrote %lld trace events to %s\n", count, filePath);
+    return true;
+}
+
+void Profiler::printReport() const
+{
+    printf("%-18s %9s %9s %9s   (ms over the last %d frames)\n", "zone", "min", "avg", "p99", getHistoryCount());
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++)
+    {
+        Stats stats = getStats((ProfileZone) z);
+        printf("%*s%-*s %9.3f %9.3f %9.3f\n", ZONE_DEPTH[z] * 2, "", 18 - ZONE_DEPTH[z] * 2,
+            ZONE_NAMES[z], stats.min, stats.avg, stats.p99);
+    }
+}
@@ -0,0 +1,119 @@
+#include "cs3113.h"
+#include <stdint.h>
+#include <chrono>
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Timed sections of a frame. Zones nest (e.g. COLLISION runs inside
+// SCENE_UPDATE), and every time is inclusive of the zones inside it.
+enum ProfileZone
+{
+    PROFILE_FRAME,         // poll to EndDrawing, vsync wait included
+    PROFILE_UPDATE,        // every simulation tick this frame
+    PROFILE_SCENE_UPDATE,
+    PROFILE_AI,            // perception scheduling, enemy updates, battle AI
+    PROFILE_COLLISION,
+    PROFILE_AUDIO,         // music streaming
+    PROFILE_RENDER,
+    PROFILE_MAP_RENDER,
+    PROFILE_ENTITY_RENDER, // sprite batch build and flush
+    PROFILE_HUD,
+    PROFILE_ZONE_COUNT
+};
+
+// Per-frame CPU timings for each zone, kept for the last HISTORY_FRAMES
+// frames, plus a ring of individual timed sections for trace export.
+// Only ever used from the main thread.
+class Profiler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static const int HISTORY_FRAMES = 240; // 4 s at 60 fps
+    static const int TRACE_CAPACITY = 16384;
+
+    struct Stats { float min, avg, p99; }; // milliseconds
+
+private:
+    struct TraceEvent
+    {
+        uint8_t  zone;
+        int64_t  startMicroseconds; // since the profiler was created
+        int32_t  durationMicroseconds;
+    };
+
+    Clock::time_point mEpoch;
+    Clock::time_point mFrameStart;
+
+    double mCurrent[PROFILE_ZONE_COUNT];                  // this frame, microseconds
+    float  mHistory[HISTORY_FRAMES][PROFILE_ZONE_COUNT];  // milliseconds
+    long long mFrameCount = 0;                            // frames completed
+
+    TraceEvent *mTrace = nullptr;
+    long long   mTraceCount = 0; // events ever recorded; the ring keeps the newest
+
+    bool mEnabled        = true;
+    bool mOverlayVisible = false;
+
+    int getHistoryCount() const;
+    const float *getHistoryFrame(int age) const; // 0 = newest
+
+public:
+    Profiler();
+    ~Profiler();
+
+    static const char *getZoneName(ProfileZone zone);
+
+    void beginFrame();
+    void endFrame();
+
+    Clock::time_point now() const { return Clock::now(); }
+    void record(ProfileZone zone, Clock::time_point start, Clock::time_point end);
+
+    Stats getStats(ProfileZone zone) const;
+
+    // While disabled, timers and frames are not recorded
+    void setEnabled(bool enabled) { mEnabled = enabled; }
+    bool isEnabled() const        { return mEnabled;    }
+
+    void toggleOverlay()          { mOverlayVisible = !mOverlayVisible; }
+    bool isOverlayVisible() const { return mOverlayVisible;             }
+    void drawOverlay(int x, int y) const;
+
+    // One row per frame in the history, one column per zone (milliseconds)
+    bool dumpCsv(const char *filePath) const;
+    // chrome://tracing / Perfetto JSON of the sections in the trace ring
+    bool dumpChromeTrace(const char *filePath) const;
+    // min/avg/p99 table on stdout
+    void printReport() const;
+};
+
+extern Profiler gProfiler;
+
+// Times the enclosing scope into a zone
+class ScopedTimer
+{
+private:
+    ProfileZone mZone;
+    bool        mActive;
+    Profiler::Clock::time_point mStart;
+
+public:
+    explicit ScopedTimer(ProfileZone zone) : mZone {zone}, mActive {gProfiler.isEnabled()}
+    {
+        if (mActive) mStart = gProfiler.now();
+    }
+    ~ScopedTimer() { if (mActive) gProfiler.record(mZone, mStart, gProfiler.now()); }
+};
+
+// Build with -DPROFILER_DISABLED to compile every timer out
+#ifndef PROFILER_DISABLED
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(zone) ScopedTimer PROFILE_CONCAT(profileTimer, __LINE__)(zone)
+#else
+#define PROFILE_SCOPE(zone)
+#endif
+
+#endif // PROFILER_H
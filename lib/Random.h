@@ -0,0 +1,77 @@
+#include <stdint.h>
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+// PCG32 random stream (O'Neill, pcg-random.org). Small, fast and fully
+// determined by (seed, sequence): two streams with different sequence ids
+// never overlap, so each subsystem can own one without sharing state.
+class RandomStream
+{
+private:
+    uint64_t mState     = 0x853C49E6748FEA9BULL;
+    uint64_t mIncrement = 0xDA3E39CB94B95BDBULL; // must be odd
+
+public:
+    RandomStream() { }
+    RandomStream(uint64_t seed, uint64_t sequence) { this->seed(seed, sequence); }
+
+    void seed(uint64_t seed, uint64_t sequence)
+    {
+        mState     = 0;
+        mIncrement = (sequence << 1u) | 1u;
+        next();
+        mState += seed;
+        next();
+    }
+
+    // Uniform 32-bit value
+    uint32_t next()
+    {
+        uint64_t old = mState;
+        mState = old * 6364136223846793005ULL + mIncrement;
+        uint32_t xorShifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+        uint32_t rotation   = (uint32_t)(old >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
+    }
+
+    // Uniform integer in [min, max], inclusive like GetRandomValue()
+    int range(int min, int max)
+    {
+        if (min > max) { int t = min; min = max; max = t; }
+        uint32_t bound = (uint32_t)((int64_t) max - min + 1);
+        if (bound == 0) return (int) next(); // full 32-bit range
+
+        // Reject the top sliver so every value is equally likely
+        uint32_t threshold = (0u - bound) % bound;
+        for (;;)
+        {
+            uint32_t value = next();
+            if (value >= threshold) return min + (int)(value % bound);
+        }
+    }
+
+    // Uniform float in [0, 1)
+    float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+};
+
+// One stream per subsystem, so e.g. opening a chest never changes which
+// enemies a later encounter rolls. Every scene's GameState owns a set.
+struct RandomStreams
+{
+    RandomStream combat;     // enemy targeting
+    RandomStream encounters; // enemy line-ups
+    RandomStream loot;       // chest contents
+    RandomStream jitter;     // follower idle motion
+
+    // salt separates owners sharing one master seed (e.g. the scene index)
+    void seed(uint64_t masterSeed, uint64_t salt)
+    {
+        combat.seed(masterSeed,     salt * 4 + 0);
+        encounters.seed(masterSeed, salt * 4 + 1);
+        loot.seed(masterSeed,       salt * 4 + 2);
+        jitter.seed(masterSeed,     salt * 4 + 3);
+    }
+};
+
+#endif // RANDOM_H
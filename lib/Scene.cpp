@@ -12,3 +12,9 @@ Scene::Scene(Vector2 origin, const char *bgHexCode) : mOrigin{origin}, mBGColour
     mGameState.bgm.ctxData = nullptr;
     ClearBackground(ColorFromHex(bgHexCode));
 }
+
+const AssetManifest &Scene::getAssetManifest() const
+{
+    static const AssetManifest NO_ASSETS;
+    return NO_ASSETS;
+}
@@ -5,6 +5,7 @@
 #include <string>
 #include "Entity.h" 
 #include "GameTypes.h" // Use shared Element, Ability, Combatant
+#include "Random.h"
 
 
 struct GameState
@@ -58,6 +59,8 @@ struct GameState
 
     int shaderStatus = 0; // 0 = normal, 1 = spotted, 2 = hidden
 
+    RandomStreams rng; // seeded by main from the session seed
+
     // UI Toast for item acquisition
     std::string itemToast = "";
     float itemToastTimer = 0.0f; // seconds remaining
@@ -78,6 +81,9 @@ public:
     virtual void update(float deltaTime) = 0;
     virtual void render() = 0;
     virtual void shutdown() = 0;
+
+    // Assets the scene uses; main.cpp keeps them resident across switches
+    virtual const AssetManifest &getAssetManifest() const;
     
     GameState&  getState()                 { return mGameState; }
     const GameState& getState() const     { return mGameState; }
@@ -5,7 +5,7 @@ ShaderProgram::~ShaderProgram()                   { unload();        }
 
 bool ShaderProgram::load(const std::string &vertexPath, const std::string &fragmentPath)
 {
-    unload(); // unload any previous shader
+    unload(); // unload any previous shader (also drops cached locations)
 
     mShader = LoadShader(vertexPath.c_str(), fragmentPath.c_str());
 
@@ -25,31 +25,72 @@ bool ShaderProgram::load(const std::string &vertexPath, const std::string &fragm
 void ShaderProgram::begin() { if (mIsLoaded) BeginShaderMode(mShader); }
 void ShaderProgram::end()   { if (mIsLoaded) EndShaderMode();          }
 
-void ShaderProgram::setVector2(const std::string &name, const Vector2 &value)
+int ShaderProgram::getUniformLocation(const std::string &name)
 {
-    if (!mIsLoaded) return;
+    if (!mIsLoaded) return NOT_LOADED;
+
+    auto it = mUniformLocations.find(name);
+    if (it != mUniformLocations.end()) return it->second;
 
     int locationID = GetShaderLocation(mShader, name.c_str());
-    if (locationID != NOT_LOADED) 
-        SetShaderValue(mShader, locationID, &value, SHADER_UNIFORM_VEC2);
+    mUniformLocations[name] = locationID;
+
+    return locationID;
 }
 
-void ShaderProgram::setFloat(const std::string &name, float value)
+void ShaderProgram::setVector2(int location, const Vector2 &value)
 {
-    if (!mIsLoaded) return;
+    if (mIsLoaded && location != NOT_LOADED)
+        SetShaderValue(mShader, location, &value, SHADER_UNIFORM_VEC2);
+}
 
-    int locationID = GetShaderLocation(mShader, name.c_str());
-    if (locationID != NOT_LOADED)
-        SetShaderValue(mShader, locationID, &value, SHADER_UNIFORM_FLOAT);
+void ShaderProgram::setFloat(int location, float value)
+{
+    if (mIsLoaded && location != NOT_LOADED)
+        SetShaderValue(mShader, location, &value, SHADER_UNIFORM_FLOAT);
+}
+
+void ShaderProgram::setInt(int location, int value)
+{
+    if (mIsLoaded && location != NOT_LOADED)
+        SetShaderValue(mShader, location, &value, SHADER_UNIFORM_INT);
+}
+
+void ShaderProgram::setVector4(int location, const Vector4 &value)
+{
+    if (mIsLoaded && location != NOT_LOADED)
+        SetShaderValue(mShader, location, &value, SHADER_UNIFORM_VEC4);
+}
+
+void ShaderProgram::setTexture(int location, const Texture2D &texture)
+{
+    if (mIsLoaded && location != NOT_LOADED)
+        SetShaderValueTexture(mShader, location, texture);
+}
+
+void ShaderProgram::setVector2(const std::string &name, const Vector2 &value)
+{
+    setVector2(getUniformLocation(name), value);
+}
+
+void ShaderProgram::setFloat(const std::string &name, float value)
+{
+    setFloat(getUniformLocation(name), value);
 }
 
 void ShaderProgram::setInt(const std::string &name, int value)
 {
-    if (!mIsLoaded) return;
+    setInt(getUniformLocation(name), value);
+}
 
-    int locationID = GetShaderLocation(mShader, name.c_str());
-    if (locationID != NOT_LOADED)
-        SetShaderValue(mShader, locationID, &value, SHADER_UNIFORM_INT);
+void ShaderProgram::setVector4(const std::string &name, const Vector4 &value)
+{
+    setVector4(getUniformLocation(name), value);
+}
+
+void ShaderProgram::setTexture(const std::string &name, const Texture2D &texture)
+{
+    setTexture(getUniformLocation(name), texture);
 }
 
 void ShaderProgram::unload()
@@ -58,6 +99,7 @@ void ShaderProgram::unload()
     {
         UnloadShader(mShader);
         mShader = { 0 };
+        mUniformLocations.clear();
         mIsLoaded = false;
     }
 }
\ No newline at end of file
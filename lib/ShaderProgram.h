@@ -9,6 +9,10 @@ private:
     Shader mShader;
     bool mIsLoaded;
 
+    // Uniform name -> location, filled on first lookup and cleared on
+    // load/unload. Misses are cached as NOT_LOADED too.
+    std::map<std::string, int> mUniformLocations;
+
 public:
     static constexpr int NOT_LOADED = -1;
 
@@ -24,10 +28,25 @@ public:
     void begin();
     void end();
 
-    // Set uniform by name
+    // Resolves (once) and returns a uniform's location, or NOT_LOADED.
+    // Look locations up after load() and keep them for per-frame setters.
+    int getUniformLocation(const std::string &name);
+
+    // Set uniform by location; NOT_LOADED is ignored
+    void setVector2(int location, const Vector2 &value);
+    void setFloat(int location, float value);
+    void setInt(int location, int value);
+    void setVector4(int location, const Vector4 &value);
+    // Binds a texture to a sampler uniform; raylib drops extra samplers
+    // whenever its batch is flushed, so call this after BeginMode2D()
+    void setTexture(int location, const Texture2D &texture);
+
+    // Set uniform by name (goes through the location cache)
     void setVector2(const std::string &name, const Vector2 &value);
     void setFloat(const std::string &name, float value);
     void setInt(const std::string &name, int value);
+    void setVector4(const std::string &name, const Vector4 &value);
+    void setTexture(const std::string &name, const Texture2D &texture);
 
     // Getters
     Shader &getShader()     { return mShader;   }
@@ -0,0 +1,76 @@
+#include "SpatialHash.h"
+#include "Entity.h"
+#include <algorithm>
+
+SpatialHash::SpatialHash(float cellSize) : mCellSize {cellSize > 0.0f ? cellSize : 64.0f} { }
+
+void SpatialHash::setCellSize(float cellSize)
+{
+    if (cellSize <= 0.0f || cellSize == mCellSize) return;
+
+    // Existing entries were bucketed with the old size
+    clear();
+    mCells.clear();
+    mCellSize = cellSize;
+}
+
+int SpatialHash::cellCoordinate(float worldCoordinate) const
+{
+    return (int) floorf(worldCoordinate / mCellSize);
+}
+
+long long SpatialHash::cellKey(int cellX, int cellY)
+{
+    return ((long long) cellX << 32) ^ (long long) (unsigned int) cellY;
+}
+
+void SpatialHash::clear()
+{
+    for (long long key : mOccupiedCells) mCells[key].clear();
+    mOccupiedCells.clear();
+    mMaxHalfExtent = 0.0f;
+}
+
+void SpatialHash::insert(Entity *entity)
+{
+    if (entity == nullptr) return;
+
+    Vector2 position   = entity->getPosition();
+    Vector2 dimensions = entity->getColliderDimensions();
+    mMaxHalfExtent = fmaxf(mMaxHalfExtent, fmaxf(dimensions.x, dimensions.y) / 2.0f);
+
+    long long key = cellKey(cellCoordinate(position.x), cellCoordinate(position.y));
+    std::vector<Entity*> &bucket = mCells[key];
+    if (bucket.empty()) mOccupiedCells.push_back(key);
+    bucket.push_back(entity);
+}
+
+void SpatialHash::query(Rectangle area, std::vector<Entity*> &results) const
+{
+    size_t firstResult = results.size();
+
+    int minX = cellCoordinate(area.x - mMaxHalfExtent);
+    int maxX = cellCoordinate(area.x + area.width  + mMaxHalfExtent);
+    int minY = cellCoordinate(area.y - mMaxHalfExtent);
+    int maxY = cellCoordinate(area.y + area.height + mMaxHalfExtent);
+
+    for (int cellY = minY; cellY <= maxY; cellY++)
+    {
+        for (int cellX = minX; cellX <= maxX; cellX++)
+        {
+            auto it = mCells.find(cellKey(cellX, cellY));
+            if (it == mCells.end()) continue;
+
+            results.insert(results.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    // Each entity lives in exactly one cell, so there are no duplicates;
+    // sorting only makes the order independent of the hash layout
+    std::sort(results.begin() + firstResult, results.end());
+}
+
+void SpatialHash::queryRadius(Vector2 centre, float radius, std::vector<Entity*> &results) const
+{
+    query({ centre.x - radius, centre.y - radius, radius * 2.0f, radius * 2.0f }, results);
+}
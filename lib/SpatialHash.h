@@ -0,0 +1,44 @@
+#include "cs3113.h"
+#include <unordered_map>
+
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+class Entity;
+
+// Uniform-grid broadphase. Entities are bucketed by the cell holding their
+// centre; queries widen the search area by the largest collider inserted, so
+// a query only touches the cells around it instead of every entity.
+// Buckets keep their capacity across clear(), so rebuilding each frame does
+// not allocate once the grid has warmed up.
+class SpatialHash
+{
+private:
+    float mCellSize;
+    float mMaxHalfExtent = 0.0f; // largest collider half-size inserted since clear()
+
+    std::unordered_map<long long, std::vector<Entity*>> mCells;
+    std::vector<long long> mOccupiedCells; // cells with entries, for a cheap clear()
+
+    int cellCoordinate(float worldCoordinate) const;
+    static long long cellKey(int cellX, int cellY);
+
+public:
+    // Cell size should be around the largest query range; two map tiles
+    // covers chest, ambush and follower separation ranges
+    explicit SpatialHash(float cellSize = 64.0f);
+
+    void setCellSize(float cellSize);
+    float getCellSize() const { return mCellSize; }
+
+    void clear();
+    void insert(Entity *entity);
+
+    // Appends every entity whose collider may overlap the area (broadphase
+    // only; callers still run their exact test). Results are in address
+    // order, so entities from one array come back in index order.
+    void query(Rectangle area, std::vector<Entity*> &results) const;
+    void queryRadius(Vector2 centre, float radius, std::vector<Entity*> &results) const;
+};
+
+#endif // SPATIAL_HASH_H
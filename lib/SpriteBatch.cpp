@@ -0,0 +1,56 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+
+void SpriteBatch::begin(const Camera2D *camera)
+{
+    mBeginTime = gProfiler.now();
+    mEntries.clear();
+    mIsCulling = camera != nullptr;
+    if (mIsCulling) mVisibleArea = getCameraBounds(camera);
+}
+
+void SpriteBatch::submit(const SpriteQuad &quad, int layer)
+{
+    if (quad.texture.id == 0) return;
+
+    if (mIsCulling)
+    {
+        // Conservative bounds: any rotation about the origin stays inside this
+        float reach = fabsf(quad.destination.width) + fabsf(quad.destination.height);
+        Rectangle bounds = {
+            quad.destination.x - reach, quad.destination.y - reach,
+            reach * 2.0f, reach * 2.0f
+        };
+        if (!CheckCollisionRecs(bounds, mVisibleArea)) return;
+    }
+
+    mEntries.push_back({ quad, layer, (int) mEntries.size() });
+}
+
+void SpriteBatch::flush()
+{
+    std::sort(mEntries.begin(), mEntries.end(), [](const Entry &a, const Entry &b)
+    {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.quad.texture.id != b.quad.texture.id) return a.quad.texture.id < b.quad.texture.id;
+        return a.order < b.order;
+    });
+
+    mTextureSwitches = 0;
+    unsigned int boundTexture = 0;
+    for (const Entry &entry : mEntries)
+    {
+        const SpriteQuad &quad = entry.quad;
+        if (quad.texture.id != boundTexture)
+        {
+            boundTexture = quad.texture.id;
+            mTextureSwitches++;
+        }
+
+        DrawTexturePro(quad.texture, quad.source, quad.destination,
+            quad.origin, quad.rotation, quad.tint);
+    }
+
+    mEntries.clear();
+    gProfiler.record(PROFILE_ENTITY_RENDER, mBeginTime, gProfiler.now());
+}
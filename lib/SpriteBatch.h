@@ -0,0 +1,53 @@
+#include "cs3113.h"
+#include "Profiler.h"
+
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+// One textured quad, in DrawTexturePro() terms
+struct SpriteQuad
+{
+    Texture2D texture;
+    Rectangle source;
+    Rectangle destination;
+    Vector2   origin;
+    float     rotation;
+    Color     tint;
+};
+
+// Draw order buckets; lower layers are drawn first
+enum SpriteLayer { LAYER_PROPS, LAYER_ENEMIES, LAYER_PARTY };
+
+// Collects a frame's sprites, drops the ones outside the camera, and draws
+// them grouped by layer, then texture. raylib only starts a new draw call
+// when the bound texture changes, so sprites sharing an atlas (followers,
+// guards) go out together. Within a layer and texture, submission order is
+// kept.
+class SpriteBatch
+{
+private:
+    struct Entry
+    {
+        SpriteQuad quad;
+        int        layer;
+        int        order;
+    };
+
+    std::vector<Entry> mEntries; // kept between frames to reuse capacity
+    Rectangle mVisibleArea = { 0.0f, 0.0f, 0.0f, 0.0f };
+    bool      mIsCulling   = false;
+    int       mTextureSwitches = 0;
+    Profiler::Clock::time_point mBeginTime; // begin() to flush() is entity render time
+
+public:
+    // Starts a batch; with a camera, sprites outside its view are skipped
+    void begin(const Camera2D *camera = nullptr);
+    void submit(const SpriteQuad &quad, int layer);
+    // Draws everything submitted since begin() and empties the batch
+    void flush();
+
+    // Texture changes in the last flush (an upper bound on its draw calls)
+    int getTextureSwitches() const { return mTextureSwitches; }
+};
+
+#endif // SPRITE_BATCH_H
@@ -121,4 +121,36 @@ void panCamera(Camera2D *camera, const Vector2 *targetPosition)
         camera->target, 
         Vector2Scale(positionDifference, 0.1f)
     ); // 0.1 = smoothing factor
-}
\ No newline at end of file
+}
+/**
+ * The function `getCameraBounds` returns the axis-aligned rectangle of world space that is
+ * visible through a 2D camera on the current screen.
+ * 
+ * @param camera The `camera` parameter is a pointer to the `Camera2D` used for drawing the world.
+ * 
+ * @return A `Rectangle` in world coordinates that encloses everything the camera can see. Rotated
+ * cameras are handled by bounding all four projected screen corners.
+ */
+Rectangle getCameraBounds(const Camera2D *camera)
+{
+    float screenWidth  = (float) GetScreenWidth();
+    float screenHeight = (float) GetScreenHeight();
+
+    Vector2 corners[4] = {
+        GetScreenToWorld2D({ 0.0f,        0.0f         }, *camera),
+        GetScreenToWorld2D({ screenWidth, 0.0f         }, *camera),
+        GetScreenToWorld2D({ 0.0f,        screenHeight }, *camera),
+        GetScreenToWorld2D({ screenWidth, screenHeight }, *camera)
+    };
+
+    Vector2 minimum = corners[0];
+    Vector2 maximum = corners[0];
+
+    for (int i = 1; i < 4; i++)
+    {
+        minimum = { fminf(minimum.x, corners[i].x), fminf(minimum.y, corners[i].y) };
+        maximum = { fmaxf(maximum.x, corners[i].x), fmaxf(maximum.y, corners[i].y) };
+    }
+
+    return { minimum.x, minimum.y, maximum.x - minimum.x, maximum.y - minimum.y };
+}
@@ -22,6 +22,7 @@ void Normalise(Vector2 *vector);
 float GetLength(const Vector2 vector);
 Rectangle getUVRectangle(const Texture2D *texture, int index, int rows, int cols);
 void panCamera(Camera2D *camera, const Vector2 *targetPosition);
+Rectangle getCameraBounds(const Camera2D *camera);
 
 
 #endif // CS3113_H
\ No newline at end of file
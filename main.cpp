@@ -12,12 +12,17 @@
 #include "lib/cs3113.h"
 #include "lib/GameTypes.h"
 #include "lib/GameData.h"
+#include "lib/CombatRules.h"
 #include "scenes/LevelOne.h"
 #include "scenes/LevelTwo.h"
 #include "scenes/LevelThree.h"
 #include "scenes/CombatScene.h"
 #include "scenes/StartMenu.h"
 #include "lib/ShaderProgram.h"
+#include "lib/AssetCache.h"
+#include "lib/Input.h"
+#include "lib/AIScheduler.h"
+#include "lib/Profiler.h"
 #include <iostream>
 #include <unordered_map>
 
@@ -26,6 +31,12 @@ constexpr int SCREEN_WIDTH  = 1000;
 constexpr int SCREEN_HEIGHT = 600;
 constexpr int TARGET_FPS    = 60;
 
+// The simulation always advances in fixed 60 Hz ticks; rendering
+// interpolates between the last two. A long frame (e.g. a scene load) is
+// clamped so it costs at most MAX_FRAME_TIME worth of ticks.
+constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
+constexpr float MAX_FRAME_TIME = 0.25f;
+
 // Scene indices (order in gLevels)
 constexpr int IDX_LEVEL_ONE   = 0;
 constexpr int IDX_LEVEL_TWO   = 1;
@@ -37,7 +48,10 @@ GameStatus gGameStatus = EXPLORATION;
 AppStatus gAppStatus   = RUNNING;
 
 float gPreviousTicks   = 0.0f;
+float gTimeAccumulator = 0.0f; // real time not yet simulated
+Camera2D gPreviousCamera = {}; // scene camera at the start of the tick
 int gCurrentLevelIndex = -1;
+uint64_t gSessionSeed  = 0; // every scene's random streams derive from this
 
 Scene *gCurrentScene = nullptr;
 std::vector<Scene*> gLevels;
@@ -64,10 +78,7 @@ void EquipPersona(int index) {
     Combatant& joker = gParty[0]; // Joker is always index 0
 
     // Overwrite Joker's Stats
-    joker.baseAttack  = p.baseAttack;
-    joker.baseDefense = p.baseDefense;
-    joker.skills      = p.skills;
-    joker.weaknesses  = p.weaknesses;
+    applyPersona(joker, p);
 
     std::cout << "Equipped Persona: " << p.name << std::endl;
 }
@@ -76,8 +87,14 @@ void EquipPersona(int index) {
 std::vector<std::vector<bool>> gSceneEnemyDefeated; 
 std::vector<std::vector<bool>> gSceneOpenedChests;
 std::vector<std::vector<bool>> gSceneRevealedTiles;
+std::vector<bool> gSceneResident; // scene's asset manifest is pinned in gAssetCache
 
 ShaderProgram gShader;
+// Uniform locations resolved once after the shader loads
+int gStatusLocation        = ShaderProgram::NOT_LOADED;
+int gLightPositionLocation = ShaderProgram::NOT_LOADED;
+int gFogMaskLocation       = ShaderProgram::NOT_LOADED;
+int gFogBoundsLocation     = ShaderProgram::NOT_LOADED;
 
 // GLOBAL TRANSITION (Fade In/Out)
 enum TransitionPhase { T_NONE, T_FADE_OUT, T_SWITCH, T_FADE_IN };
@@ -213,6 +230,9 @@ void switchToScene(int sceneIndex);
 void initialise();
 void processInput();
 void update();
+void fixedUpdate(float deltaTime);
+void handleSceneRequest();
+void savePreviousState();
 void render();
 void shutdown();
 
@@ -225,11 +245,30 @@ void switchToScene(int sceneIndex)
     gCurrentLevelIndex = sceneIndex; // set before initialise so scene can use index
     // Ensure transition request flag starts cleared to avoid accidental immediate switches
     gCurrentScene->getState().nextSceneID = -1;
+
+    // First visit pins the scene's assets for the rest of the session, so
+    // later switches (e.g. in and out of combat) load nothing from disk
+    if (!gSceneResident[sceneIndex]) {
+        gAssetCache.retainManifest(gCurrentScene->getAssetManifest());
+        gSceneResident[sceneIndex] = true;
+    }
+
     gCurrentScene->initialise();
 
     // Ensure scene state starts with the current global inventory
     // Prevents first update() from overriding with empty scene inventory
     gCurrentScene->getState().inventory = gInventory;
+
+    // The new scene starts where initialise() put it (nothing to interpolate
+    // from), and the time spent loading is not simulated
+    savePreviousState();
+    gPreviousTicks = (float) GetTime();
+}
+
+void savePreviousState()
+{
+    gEntityStore.savePreviousPositions();
+    gPreviousCamera = gCurrentScene->getState().camera;
 }
 
 
@@ -240,7 +279,7 @@ void initialise()
     SetExitKey(KEY_NULL);
 
 
-    // Load Initial Party from Data Header
+    // Load Initial Party from the content database (loaded in main)
     gParty = INITIAL_PARTY(); 
     gInventory = INITIAL_INVENTORY();
     gOwnedEquipment = INITIAL_EQUIPMENTS();
@@ -252,31 +291,36 @@ void initialise()
     // Initialize Audio (Requirement 6)
     InitAudioDevice();
     // Load SFX
-    gSndBack = LoadSound("assets/audio/back.wav");
-    gSndCrit = LoadSound("assets/audio/crit.wav");
-    gSndGun  = LoadSound("assets/audio/gun.wav");
-    gSndHeal = LoadSound("assets/audio/heal.wav");
-    gSndHit  = LoadSound("assets/audio/hit.wav");
-    gSndMenu = LoadSound("assets/audio/menu.wav");
+    gSndBack = gAssetCache.acquireSound("assets/audio/back.wav");
+    gSndCrit = gAssetCache.acquireSound("assets/audio/crit.wav");
+    gSndGun  = gAssetCache.acquireSound("assets/audio/gun.wav");
+    gSndHeal = gAssetCache.acquireSound("assets/audio/heal.wav");
+    gSndHit  = gAssetCache.acquireSound("assets/audio/hit.wav");
+    gSndMenu = gAssetCache.acquireSound("assets/audio/menu.wav");
     ApplySFXVolumes();
 
     gShader.load("shaders/vertex.glsl", "shaders/fragment.glsl");
+    gStatusLocation        = gShader.getUniformLocation("status");
+    gLightPositionLocation = gShader.getUniformLocation("lightPosition");
+    gFogMaskLocation       = gShader.getUniformLocation("fogMask");
+    gFogBoundsLocation     = gShader.getUniformLocation("fogBounds");
 
     // Load HUD icons (Task 0 prerequisite)
-    gPartyIcons[0] = LoadTexture("assets/icon_joker.png");
-    gPartyIcons[1] = LoadTexture("assets/icon_skull.png");
-    gPartyIcons[2] = LoadTexture("assets/icon_mona.png");
-    gPartyIcons[3] = LoadTexture("assets/icon_noir.png");
+    gPartyIcons[0] = gAssetCache.acquireTexture("assets/icon_joker.png");
+    gPartyIcons[1] = gAssetCache.acquireTexture("assets/icon_skull.png");
+    gPartyIcons[2] = gAssetCache.acquireTexture("assets/icon_mona.png");
+    gPartyIcons[3] = gAssetCache.acquireTexture("assets/icon_noir.png");
 
     // Reset global enemy defeat tracking at app start (new session)
     gSceneEnemyDefeated.clear();
 }
 
+// Runs once per simulation tick (and once per frame while paused), after
+// gInput.beginTick(), so recorded input replays exactly
 void processInput() 
 {
-    if ( WindowShouldClose()) gAppStatus = TERMINATED;
     // Enter pause menu with ESC from exploration
-    if (IsKeyPressed(KEY_ESCAPE)) {
+    if (gInput.isPressed(KEY_ESCAPE)) {
         if (gGameStatus == EXPLORATION) {
             OpenPauseMenu();
         }
@@ -286,10 +330,10 @@ void processInput()
         gCurrentScene->getState().player->resetMovement();
 
         // Movements during exploration (use IsKeyDown so holding the key moves continuously)
-        if (IsKeyDown(KEY_A)) gCurrentScene->getState().player->moveLeft();
-        if (IsKeyDown(KEY_D)) gCurrentScene->getState().player->moveRight();
-        if (IsKeyDown(KEY_W)) gCurrentScene->getState().player->moveUp();
-        if (IsKeyDown(KEY_S)) gCurrentScene->getState().player->moveDown();
+        if (gInput.isDown(KEY_A)) gCurrentScene->getState().player->moveLeft();
+        if (gInput.isDown(KEY_D)) gCurrentScene->getState().player->moveRight();
+        if (gInput.isDown(KEY_W)) gCurrentScene->getState().player->moveUp();
+        if (gInput.isDown(KEY_S)) gCurrentScene->getState().player->moveDown();
 
         // Normalize diagonal movement so speed is consistent
         if (GetLength(gCurrentScene->getState().player->getMovement()) > 1.0f) {
@@ -298,7 +342,7 @@ void processInput()
     }
     
     else if  ( gGameStatus == GAME_OVER) {
-        if (IsKeyPressed(KEY_R)) {
+        if (gInput.isPressed(KEY_R)) {
             gCurrentScene->shutdown();
             initialise();
             switchToScene(0);
@@ -310,7 +354,7 @@ void processInput()
     if (gGameStatus == PAUSED) 
     {
         //  BACK / CANCEL LOGIC
-        if (!gPauseJustOpened && (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_C))) {
+        if (!gPauseJustOpened && (gInput.isPressed(KEY_ESCAPE) || gInput.isPressed(KEY_C))) {
             if (gSndBack.frameCount) PlaySound(gSndBack);
             switch (gPauseState) {
                 case P_SKILL_TARGET_ALLY:
@@ -356,10 +400,10 @@ void processInput()
         if (gPauseState == P_MAIN) {
             // Options: SKILL, ITEM, EQUIP, PERSONA, SYSTEM
             const int OPTION_COUNT = 5;
-            if (IsKeyPressed(KEY_UP))   gMenuSelection = (gMenuSelection - 1 + OPTION_COUNT) % OPTION_COUNT;
-            if (IsKeyPressed(KEY_DOWN)) gMenuSelection = (gMenuSelection + 1) % OPTION_COUNT;
+            if (gInput.isPressed(KEY_UP))   gMenuSelection = (gMenuSelection - 1 + OPTION_COUNT) % OPTION_COUNT;
+            if (gInput.isPressed(KEY_DOWN)) gMenuSelection = (gMenuSelection + 1) % OPTION_COUNT;
             
-            if (!gPauseJustOpened && (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_ENTER))) {
+            if (!gPauseJustOpened && (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE) || gInput.isPressed(KEY_ENTER))) {
                 if (gSndMenu.frameCount) PlaySound(gSndMenu);
                 if (gMenuSelection == 0) { // SKILL
                     gPauseState = P_PARTY_SELECT;
@@ -386,11 +430,11 @@ void processInput()
         // PARTY SELECTION (Shared for SKILL & EQUIP)
         else if (gPauseState == P_PARTY_SELECT) {
             if (!gParty.empty()) {
-                if (IsKeyPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + (int)gParty.size()) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
-                if (IsKeyPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + (int)gParty.size()) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
             }
 
-            if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+            if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                 if (gSndMenu.frameCount) PlaySound(gSndMenu);
                 gSelectedMemberIdx = gSubMenuSelection;
                 if (gMenuSelection == 0) { // SKILL
@@ -407,15 +451,15 @@ void processInput()
             std::vector<ItemGroup> groups = BuildInventoryGroups();
             if (groups.empty()) {
                 // No items; back to main
-                if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+                if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                     if (gSndBack.frameCount) PlaySound(gSndBack);
                     gPauseState = P_MAIN;
                     gMenuSelection = 0;
                 }
             } else {
-                if (IsKeyPressed(KEY_UP))   { gItemGroupSelection = (gItemGroupSelection - 1 + (int)groups.size()) % (int)groups.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
-                if (IsKeyPressed(KEY_DOWN)) { gItemGroupSelection = (gItemGroupSelection + 1) % (int)groups.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
-                if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+                if (gInput.isPressed(KEY_UP))   { gItemGroupSelection = (gItemGroupSelection - 1 + (int)groups.size()) % (int)groups.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_DOWN)) { gItemGroupSelection = (gItemGroupSelection + 1) % (int)groups.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                     if (gSndMenu.frameCount) PlaySound(gSndMenu);
                     // Go to target selection to apply item
                     gPauseState = P_ITEM_TARGET_ALLY;
@@ -428,11 +472,11 @@ void processInput()
         // ITEM TARGETING (Apply item to ally)
         else if (gPauseState == P_ITEM_TARGET_ALLY) {
             if (!gParty.empty()) {
-                if (IsKeyPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + (int)gParty.size()) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
-                if (IsKeyPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + (int)gParty.size()) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
             }
 
-            if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+            if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                 // Use first occurrence of selected grouped item
                 std::vector<ItemGroup> groups = BuildInventoryGroups();
                 int idxItem = -1;
@@ -476,11 +520,11 @@ void processInput()
             std::vector<int> healIndices = GetHealingSkillIndices(actor);
 
             if (!healIndices.empty()) {
-                if (IsKeyPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + (int)healIndices.size()) % (int)healIndices.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
-                if (IsKeyPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % (int)healIndices.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + (int)healIndices.size()) % (int)healIndices.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % (int)healIndices.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
 
                 // SELECT SKILL -> GO TO TARGETING
-                if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+                if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                     gSelectedSkillIdx = healIndices[gSubMenuSelection]; // Store actual index
                     Ability& skill = actor.skills[gSelectedSkillIdx];
 
@@ -501,12 +545,12 @@ void processInput()
         // SKILL TARGETING (Apply the Heal)
         else if (gPauseState == P_SKILL_TARGET_ALLY) {
             if (!gParty.empty()) {
-                if (IsKeyPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + (int)gParty.size()) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
-                if (IsKeyPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + (int)gParty.size()) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % (int)gParty.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
             }
 
             // CONFIRM HEAL
-            if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+            if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                 Combatant& actor = gParty[gSelectedMemberIdx];
                 Combatant& target = gParty[gSubMenuSelection];
                 Ability& skill = actor.skills[gSelectedSkillIdx];
@@ -530,10 +574,10 @@ void processInput()
         // SYSTEM MENU
         else if (gPauseState == P_SYSTEM) {
             // Options: 0: Audio, 1: Quit
-            if (IsKeyPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + 2) % 2; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
-            if (IsKeyPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % 2; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+            if (gInput.isPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + 2) % 2; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+            if (gInput.isPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % 2; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
 
-            if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+            if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                 if (gSubMenuSelection == 0) {
                     if (gSndMenu.frameCount) PlaySound(gSndMenu);
                     gPauseState = P_AUDIO_SETTINGS;
@@ -547,8 +591,8 @@ void processInput()
         // AUDIO SETTINGS
         else if (gPauseState == P_AUDIO_SETTINGS) {
             // 0: Master, 1: Music, 2: SFX
-            if (IsKeyPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + 3) % 3; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
-            if (IsKeyPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % 3; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+            if (gInput.isPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + 3) % 3; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+            if (gInput.isPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % 3; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
 
             // Adjust Volume
             float* targetVol = nullptr;
@@ -561,8 +605,8 @@ void processInput()
             }
 
             if (targetVol) {
-                if (IsKeyDown(KEY_LEFT))  *targetVol -= 0.01f;
-                if (IsKeyDown(KEY_RIGHT)) *targetVol += 0.01f;
+                if (gInput.isDown(KEY_LEFT))  *targetVol -= 0.01f;
+                if (gInput.isDown(KEY_RIGHT)) *targetVol += 0.01f;
                 
                 // Clamp
                 if (*targetVol < 0.0f) *targetVol = 0.0f;
@@ -580,11 +624,11 @@ void processInput()
         else if (gPauseState == P_PERSONA) {
             if (!gOwnedPersonas.empty()) {
                 // Navigate List
-                if (IsKeyPressed(KEY_UP))   gSubMenuSelection = (gSubMenuSelection - 1 + (int)gOwnedPersonas.size()) % (int)gOwnedPersonas.size();
-                if (IsKeyPressed(KEY_DOWN)) gSubMenuSelection = (gSubMenuSelection + 1) % (int)gOwnedPersonas.size();
+                if (gInput.isPressed(KEY_UP))   gSubMenuSelection = (gSubMenuSelection - 1 + (int)gOwnedPersonas.size()) % (int)gOwnedPersonas.size();
+                if (gInput.isPressed(KEY_DOWN)) gSubMenuSelection = (gSubMenuSelection + 1) % (int)gOwnedPersonas.size();
 
                 // Equip Selection
-                if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+                if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                     EquipPersona(gSubMenuSelection);
                 }
             }
@@ -593,11 +637,11 @@ void processInput()
         // EQUIP VIEW (Select Slot)
         else if (gPauseState == P_EQUIP_VIEW) {
             // 0=Melee, 1=Gun, 2=Armor
-            if (IsKeyPressed(KEY_UP))   { gSelectedEquipSlot = (gSelectedEquipSlot - 1 + 3) % 3; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
-            if (IsKeyPressed(KEY_DOWN)) { gSelectedEquipSlot = (gSelectedEquipSlot + 1) % 3; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+            if (gInput.isPressed(KEY_UP))   { gSelectedEquipSlot = (gSelectedEquipSlot - 1 + 3) % 3; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+            if (gInput.isPressed(KEY_DOWN)) { gSelectedEquipSlot = (gSelectedEquipSlot + 1) % 3; if (gSndMenu.frameCount) PlaySound(gSndMenu); }
 
             // Enter Selection -> Go to Bag List
-            if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+            if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                 if (gSndMenu.frameCount) PlaySound(gSndMenu);
                 gPauseState = P_EQUIP_LIST;
                 gSubMenuSelection = 0;
@@ -613,11 +657,11 @@ void processInput()
             std::vector<int> validIndices = GetEquipIndicesByType(targetType);
 
             if (!validIndices.empty()) {
-                if (IsKeyPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + (int)validIndices.size()) % (int)validIndices.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
-                if (IsKeyPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % (int)validIndices.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_UP))   { gSubMenuSelection = (gSubMenuSelection - 1 + (int)validIndices.size()) % (int)validIndices.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
+                if (gInput.isPressed(KEY_DOWN)) { gSubMenuSelection = (gSubMenuSelection + 1) % (int)validIndices.size(); if (gSndMenu.frameCount) PlaySound(gSndMenu); }
 
                 // SWAP ITEM
-                if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+                if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                     if (gSndMenu.frameCount) PlaySound(gSndMenu);
                     Combatant& c = gParty[gSelectedMemberIdx];
                     int realIdx = validIndices[gSubMenuSelection];
@@ -658,71 +702,157 @@ void update()
 {
     // Always update current scene music stream 
     if (gCurrentScene && gCurrentScene->getState().bgm.ctxData) {
+        PROFILE_SCOPE(PROFILE_AUDIO);
         UpdateMusicStream(gCurrentScene->getState().bgm);
         SetMusicVolume(gCurrentScene->getState().bgm, gMusicVolume);
     }
-    if (gGameStatus != PAUSED) {
-        float ticks = (float) GetTime();
-        float deltaTime = ticks - gPreviousTicks;
-        gPreviousTicks  = ticks;
-
-        // Handle global fade transition phases
-        if (gTransitionPhase == T_FADE_OUT) {
-            gTransitionAlpha += deltaTime * 2.0f; // ~0.5s fade
-            if (gTransitionAlpha >= 1.0f) { gTransitionAlpha = 1.0f; gTransitionPhase = T_SWITCH; }
-        }
-        if (gTransitionPhase == T_SWITCH) {
-            if (gPendingSceneID >= 0) {
-                // Apply party stat boosts exactly once at the actual switch moment
-                if (gCurrentLevelIndex == IDX_LEVEL_ONE && gPendingSceneID == IDX_LEVEL_TWO) {
-                    const int hpBoost = 30;
-                    const int spBoost = 15;
-                    const int atkBoost = 10;
-                    const int defBoost = 8;
-                    for (auto &m : gParty) {
-                        m.maxHp += hpBoost;
-                        m.currentHp = std::min(m.currentHp + hpBoost, m.maxHp);
-                        m.maxSp += spBoost;
-                        m.currentSp = std::min(m.currentSp + spBoost, m.maxSp);
-                        m.baseAttack += atkBoost;
-                        m.baseDefense += defBoost;
-                    }
-                }
+    if (gGameStatus == PAUSED) {
+        // The pause menu has no simulation ticks; it reads one input snapshot per frame
+        gInput.beginTick();
+        processInput();
+        handleSceneRequest();
+        return;
+    }
+
+    PROFILE_SCOPE(PROFILE_UPDATE);
+    float ticks = (float) GetTime();
+    float frameTime = ticks - gPreviousTicks;
+    gPreviousTicks  = ticks;
+    if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+
+    gTimeAccumulator += frameTime;
+    while (gTimeAccumulator >= FIXED_TIMESTEP) {
+        gInput.beginTick();
+        processInput();
+
+        // The pause menu stops the simulation mid-frame
+        if (gGameStatus == PAUSED) { gTimeAccumulator = 0.0f; break; }
+
+        savePreviousState();
+        fixedUpdate(FIXED_TIMESTEP);
+        handleSceneRequest();
+        gTimeAccumulator -= FIXED_TIMESTEP;
+    }
+
+    // How far this frame sits between the previous tick and the current one
+    gEntityStore.renderAlpha = gTimeAccumulator / FIXED_TIMESTEP;
+}
+
+// One simulation tick
+void fixedUpdate(float deltaTime)
+{
+    // Handle global fade transition phases
+    if (gTransitionPhase == T_FADE_OUT) {
+        // Upload whatever the background loader has decoded so far
+        gAssetCache.uploadPrefetched();
 
-                gCurrentScene->shutdown();
-                switchToScene(gPendingSceneID);
-                // Set game status based on target
-                gGameStatus = (gPendingSceneID == IDX_COMBAT) ? COMBAT : EXPLORATION;
-                gPendingSceneID = -1;
+        gTransitionAlpha += deltaTime * 2.0f; // ~0.5s fade
+        if (gTransitionAlpha >= 1.0f) { gTransitionAlpha = 1.0f; gTransitionPhase = T_SWITCH; }
+    }
+    if (gTransitionPhase == T_SWITCH) {
+        if (gPendingSceneID >= 0) {
+            // Apply party stat boosts exactly once at the actual switch moment
+            if (gCurrentLevelIndex == IDX_LEVEL_ONE && gPendingSceneID == IDX_LEVEL_TWO) {
+                applyLevelTwoBoost(gParty);
             }
-            gTransitionPhase = T_FADE_IN;
-        }
-        if (gTransitionPhase == T_FADE_IN) {
-            gTransitionAlpha -= deltaTime * 2.0f;
-            if (gTransitionAlpha <= 0.0f) { gTransitionAlpha = 0.0f; gTransitionPhase = T_NONE; }
+
+            // Normally already decoded during the fade; only waits on a slow disk
+            gAssetCache.finishPrefetch();
+
+            gCurrentScene->shutdown();
+            switchToScene(gPendingSceneID);
+            // Set game status based on target
+            gGameStatus = (gPendingSceneID == IDX_COMBAT) ? COMBAT : EXPLORATION;
+            gPendingSceneID = -1;
         }
+        gTransitionPhase = T_FADE_IN;
+    }
+    if (gTransitionPhase == T_FADE_IN) {
+        gTransitionAlpha -= deltaTime * 2.0f;
+        if (gTransitionAlpha <= 0.0f) { gTransitionAlpha = 0.0f; gTransitionPhase = T_NONE; }
+    }
 
-        // Update current scene only when not switching
-        if (gTransitionPhase != T_SWITCH) {
-            gCurrentScene->update(deltaTime);
+    // Update current scene only when not switching
+    if (gTransitionPhase != T_SWITCH) {
+        PROFILE_SCOPE(PROFILE_SCENE_UPDATE);
+        gCurrentScene->update(deltaTime);
+    }
+
+    // Tick down global item toast timer
+    GameState& st = gCurrentScene->getState();
+    if (st.itemToastTimer > 0.0f) {
+        st.itemToastTimer -= deltaTime;
+        if (st.itemToastTimer < 0.0f) st.itemToastTimer = 0.0f;
+    }
+
+    // Sync scene inventory back to global during exploration/title
+    if (gGameStatus == EXPLORATION || gGameStatus == TITLE) {
+        gInventory = st.inventory;
+    }
+}
+
+// Acts on a scene's request to switch (set in its update)
+void handleSceneRequest()
+{
+    if (gCurrentScene->getState().nextSceneID != -1) {
+        int nextID = gCurrentScene->getState().nextSceneID;
+        // Reset the request immediately to avoid reprocessing on subsequent frames
+        gCurrentScene->getState().nextSceneID = -1;
+
+        // Pass Party State to Combat
+        if (nextID == IDX_COMBAT) { 
+            gLevels[nextID]->getState().party = gParty;
+            gLevels[nextID]->getState().inventory = gInventory;
+            gLevels[nextID]->getState().returnSceneID = gCurrentLevelIndex;
+            gLevels[nextID]->getState().engagedEnemyIndex = gCurrentScene->getState().engagedEnemyIndex;
+            // Pass combat advantage determined in exploration
+            gLevels[nextID]->getState().combatAdvantage = gCurrentScene->getState().combatAdvantage;
+            // Save player position for return after combat
+            if (gCurrentScene->getState().player) {
+                gLevels[nextID]->getState().returnSpawnPos = gCurrentScene->getState().player->getPosition();
+                gLevels[nextID]->getState().hasReturnSpawnPos = true;
+            }
+            // Copy defeated enemy flags from level to combat scene
+            gLevels[nextID]->getState().defeatedEnemies = gCurrentScene->getState().defeatedEnemies;
+            // Copy opened chest flags from level to combat scene
+            gLevels[nextID]->getState().openedChests = gCurrentScene->getState().openedChests;
+            // Copy map revealed tiles from level to combat scene
+            gLevels[nextID]->getState().revealedTiles = gCurrentScene->getState().revealedTiles;
         }
 
-        // Tick down global item toast timer
-        GameState& st = gCurrentScene->getState();
-        if (st.itemToastTimer > 0.0f) {
-            st.itemToastTimer -= deltaTime;
-            if (st.itemToastTimer < 0.0f) st.itemToastTimer = 0.0f;
+        // Return from Combat: Update Global Party and restore spawn position in target level
+        if (gCurrentLevelIndex == IDX_COMBAT && nextID != IDX_COMBAT) {
+            gParty = gCurrentScene->getState().party;
+            gInventory = gCurrentScene->getState().inventory;
+            gLevels[nextID]->getState().returnSpawnPos = gCurrentScene->getState().returnSpawnPos;
+            gLevels[nextID]->getState().hasReturnSpawnPos = gCurrentScene->getState().hasReturnSpawnPos;
+            // Copy defeated enemy flags back to target level scene
+            gLevels[nextID]->getState().defeatedEnemies = gCurrentScene->getState().defeatedEnemies;
+            // Copy opened chest flags back to target level scene
+            gLevels[nextID]->getState().openedChests = gCurrentScene->getState().openedChests;
+            // Copy map revealed tiles back to target level scene
+            gLevels[nextID]->getState().revealedTiles = gCurrentScene->getState().revealedTiles;
         }
 
-        // Sync scene inventory back to global during exploration/title
-        if (gGameStatus == EXPLORATION || gGameStatus == TITLE) {
-            gInventory = st.inventory;
+        // Use global fade transition for level/combat switches (no camera tween)
+        if (nextID == IDX_START_MENU) {
+            // Immediate switch for title
+            gCurrentScene->shutdown();
+            switchToScene(nextID);
+            gGameStatus = TITLE;
+        } else {
+            gPendingSceneID = nextID;
+            gTransitionPhase = T_FADE_OUT;
+            // Decode the next scene's files while the screen fades out
+            gAssetCache.prefetch(gLevels[nextID]->getAssetManifest());
         }
     }
 }
 
 void render()
 {
+    // Timed up to EndDrawing, which waits on vsync/the frame limiter
+    Profiler::Clock::time_point renderStart = gProfiler.now();
     BeginDrawing();
     
     ClearBackground(BLACK);
@@ -732,20 +862,40 @@ void render()
     {
         gShader.begin();
 
-        gShader.setInt("status", gCurrentScene->getState().shaderStatus);
+        gShader.setInt(gStatusLocation, gCurrentScene->getState().shaderStatus);
 
         if (gCurrentScene->getState().player) {
-            Vector2 playerPos = gCurrentScene->getState().player->getPosition();
-            gShader.setVector2("lightPosition", playerPos);
+            Vector2 playerPos = gCurrentScene->getState().player->getRenderPosition();
+            gShader.setVector2(gLightPositionLocation, playerPos);
         }
         //  WORLD RENDERING 
-        BeginMode2D(gCurrentScene->getState().camera);
+        // Camera moves with the interpolated sprites
+        Camera2D camera = gCurrentScene->getState().camera;
+        camera.target = Vector2Lerp(gPreviousCamera.target, camera.target, gEntityStore.renderAlpha);
+        camera.zoom   = Lerp(gPreviousCamera.zoom, camera.zoom, gEntityStore.renderAlpha);
+        BeginMode2D(camera);
+
+        // Fog of war is applied per pixel from the map's explored-tile mask
+        Map *map = gCurrentScene->getState().map;
+        if (map) {
+            gShader.setTexture(gFogMaskLocation, map->getFogMask());
+            gShader.setVector4(gFogBoundsLocation, {
+                map->getLeftBoundary(),
+                map->getTopBoundary(),
+                map->getRightBoundary()  - map->getLeftBoundary(),
+                map->getBottomBoundary() - map->getTopBoundary()
+            });
+        } else {
+            gShader.setVector4(gFogBoundsLocation, { 0.0f, 0.0f, 0.0f, 0.0f });
+        }
+
         gCurrentScene->render();
         EndMode2D();
 
         gShader.end();
 
         //  HUD RENDERING
+        PROFILE_SCOPE(PROFILE_HUD);
         int startY = 20;
         for (int i = 0; i < (int)gParty.size(); i++) {
             Combatant& m = gParty[i];
@@ -805,6 +955,7 @@ void render()
     // PAUSED Overlay and Menu (rendered on top of scene)
     if (gGameStatus == PAUSED) 
     {
+        PROFILE_SCOPE(PROFILE_HUD);
         // DARK OVERLAY
         DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(BLACK, 0.9f));
 
@@ -1129,32 +1280,58 @@ void render()
         DrawText(st.itemToast.c_str(), x, y, fontSize, WHITE);
     }
 
+    gProfiler.record(PROFILE_RENDER, renderStart, gProfiler.now());
+    gProfiler.drawOverlay(SCREEN_WIDTH - 480, 32); // under the position readout
+
     EndDrawing();
 }
 
 void shutdown() 
 {
+    gInput.stop(); // flush the input log, if recording
     gShader.unload();
     // Unload HUD icons
     for (int i = 0; i < 4; ++i) {
         if (gPartyIcons[i].id != 0) {
-            UnloadTexture(gPartyIcons[i]);
+            gAssetCache.releaseTexture(gPartyIcons[i]);
             gPartyIcons[i] = Texture2D{};
         }
     }
-    // Unload SFX before closing audio
-    if (gSndBack.frameCount) UnloadSound(gSndBack);
-    if (gSndCrit.frameCount) UnloadSound(gSndCrit);
-    if (gSndGun.frameCount)  UnloadSound(gSndGun);
-    if (gSndHeal.frameCount) UnloadSound(gSndHeal);
-    if (gSndHit.frameCount)  UnloadSound(gSndHit);
-    if (gSndMenu.frameCount) UnloadSound(gSndMenu);
+    // Release SFX before closing audio
+    gAssetCache.releaseSound(gSndBack);
+    gAssetCache.releaseSound(gSndCrit);
+    gAssetCache.releaseSound(gSndGun);
+    gAssetCache.releaseSound(gSndHeal);
+    gAssetCache.releaseSound(gSndHit);
+    gAssetCache.releaseSound(gSndMenu);
+    // Pinned scene assets and textures still held by scene entities at exit
+    gAssetCache.unloadAll();
     CloseAudioDevice();
     CloseWindow();
 }
 
-int main()
+int main(int argc, char **argv)
 {
+    // --seed N replays a session's random rolls; otherwise seed from the clock.
+    // --record FILE logs every tick's input; --replay FILE plays a log back
+    // (with its recorded seed) in place of the keyboard.
+    gSessionSeed = (uint64_t) time(nullptr);
+    const char *recordPath = nullptr;
+    const char *replayPath = nullptr;
+    for (int i = 1; i + 1 < argc; i++) {
+        std::string arg = argv[i];
+        if      (arg == "--seed")   gSessionSeed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--record") recordPath = argv[++i];
+        else if (arg == "--replay") replayPath = argv[++i];
+    }
+    if (replayPath && !gInput.startReplay(replayPath, &gSessionSeed)) return 1;
+    if (recordPath && !replayPath && !gInput.startRecording(recordPath, gSessionSeed)) return 1;
+    // Perception must not depend on wall-clock budgets when input is replayed
+    if (recordPath || replayPath) AIScheduler::setDeterministic(true);
+    std::cout << "[main] session seed " << gSessionSeed << std::endl;
+    // All game data comes from here; checked before a window opens
+    if (!gContentDB.load(CONTENT_BLOB_PATH)) return 1;
+
     initialise();
 
     // Scene Setup
@@ -1167,68 +1344,32 @@ int main()
     gSceneEnemyDefeated.resize(gLevels.size());
     gSceneOpenedChests.resize(gLevels.size());
     gSceneRevealedTiles.resize(gLevels.size());
+    gSceneResident.resize(gLevels.size(), false);
+
+    // Each scene gets its own streams (salted by index) from the session seed
+    for (int i = 0; i < (int)gLevels.size(); i++) {
+        gLevels[i]->getState().rng.seed(gSessionSeed, (uint64_t) i);
+    }
 
     switchToScene(IDX_START_MENU);
     gGameStatus = TITLE;
 
     while (gAppStatus != TERMINATED) {
-        processInput();
-        update();
-
-        // Scene Switching Logic (Keep existing logic)
-           if (gCurrentScene->getState().nextSceneID != -1) {
-               int nextID = gCurrentScene->getState().nextSceneID;
-               // Reset the request immediately to avoid reprocessing on subsequent frames
-               gCurrentScene->getState().nextSceneID = -1;
-             
-             // Pass Party State to Combat
-            if (nextID == IDX_COMBAT) { 
-                gLevels[nextID]->getState().party = gParty;
-                gLevels[nextID]->getState().inventory = gInventory;
-                gLevels[nextID]->getState().returnSceneID = gCurrentLevelIndex;
-                gLevels[nextID]->getState().engagedEnemyIndex = gCurrentScene->getState().engagedEnemyIndex;
-                // Pass combat advantage determined in exploration
-                gLevels[nextID]->getState().combatAdvantage = gCurrentScene->getState().combatAdvantage;
-                // Save player position for return after combat
-                if (gCurrentScene->getState().player) {
-                    gLevels[nextID]->getState().returnSpawnPos = gCurrentScene->getState().player->getPosition();
-                    gLevels[nextID]->getState().hasReturnSpawnPos = true;
-                }
-                // Copy defeated enemy flags from level to combat scene
-                gLevels[nextID]->getState().defeatedEnemies = gCurrentScene->getState().defeatedEnemies;
-                // Copy opened chest flags from level to combat scene
-                gLevels[nextID]->getState().openedChests = gCurrentScene->getState().openedChests;
-                // Copy map revealed tiles from level to combat scene
-                gLevels[nextID]->getState().revealedTiles = gCurrentScene->getState().revealedTiles;
-            }
-             
-            // Return from Combat: Update Global Party and restore spawn position in target level
-            if (gCurrentLevelIndex == IDX_COMBAT && nextID != IDX_COMBAT) {
-                gParty = gCurrentScene->getState().party;
-                gInventory = gCurrentScene->getState().inventory;
-                gLevels[nextID]->getState().returnSpawnPos = gCurrentScene->getState().returnSpawnPos;
-                gLevels[nextID]->getState().hasReturnSpawnPos = gCurrentScene->getState().hasReturnSpawnPos;
-                // Copy defeated enemy flags back to target level scene
-                gLevels[nextID]->getState().defeatedEnemies = gCurrentScene->getState().defeatedEnemies;
-                // Copy opened chest flags back to target level scene
-                gLevels[nextID]->getState().openedChests = gCurrentScene->getState().openedChests;
-                // Copy map revealed tiles back to target level scene
-                gLevels[nextID]->getState().revealedTiles = gCurrentScene->getState().revealedTiles;
-            }
-
-            // Use global fade transition for level/combat switches (no camera tween)
-            if (nextID == IDX_START_MENU) {
-                // Immediate switch for title
-                gCurrentScene->shutdown();
-                switchToScene(nextID);
-                gGameStatus = TITLE;
-            } else {
-                gPendingSceneID = nextID;
-                gTransitionPhase = T_FADE_OUT;
-            }
+        gProfiler.beginFrame();
+        if (WindowShouldClose()) gAppStatus = TERMINATED;
+
+        // Debug keys go straight to raylib: they are not game input and
+        // stay out of recorded input logs
+        if (IsKeyPressed(KEY_F3)) gProfiler.toggleOverlay();
+        if (IsKeyPressed(KEY_F4)) {
+            gProfiler.dumpCsv("profile.csv");
+            gProfiler.dumpChromeTrace("profile_trace.json");
         }
 
+        gInput.poll();
+        update();
         render();
+        gProfiler.endFrame();
     }
     shutdown();
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "CombatScene.h"
 #include "../lib/Effects.h"
-#include "../lib/GameData.h" // for getRandomEnemyForLevel
+#include "../lib/CombatRules.h"
+#include "../lib/Input.h"
+#include "../lib/Profiler.h"
 #include <cmath>
 #include "raymath.h"
 
@@ -50,17 +52,29 @@ Rectangle CombatScene::GetEnemyFrameRect(Combatant& enemy, CombatState state, fl
     return source;
 }
 
-void CombatScene::SpawnFloatingText(Vector2 pos, const std::string& text, Color color, float lifetime)
+void CombatScene::SpawnFloatingText(Vector2 pos, int damage, Color color, float lifetime)
 {
     FloatingText ft;
     ft.pos = pos;
-    ft.text = text;
+    ft.damage = damage;
     ft.color = color;
     ft.lifetime = lifetime;
     ft.elapsed = 0.0f;
     mFloatingTexts.push_back(ft);
 }
 
+// Everything this scene loads, kept resident between visits
+static const AssetManifest COMBAT_ASSETS = {
+    { "assets/ui/icon_attack.png", "assets/ui/icon_gun.png", "assets/ui/icon_skill.png",
+      "assets/ui/icon_guard.png", "assets/ui/icon_item.png", "assets/ui/ui_cursor.png",
+      "assets/enemy_atlas.png", "assets/characters.png", "assets/tileset.png" },
+    { "assets/audio/menu.wav", "assets/audio/back.wav", "assets/audio/gun.wav",
+      "assets/audio/heal.wav", "assets/audio/hit.wav", "assets/audio/crit.wav" },
+    { "assets/audio/combatmusic.mp3" }
+};
+
+const AssetManifest &CombatScene::getAssetManifest() const { return COMBAT_ASSETS; }
+
 void CombatScene::initialise() {
     // Set initial turn state based on advantage
         mActiveMemberIndex = 0;
@@ -68,12 +82,13 @@ void CombatScene::initialise() {
         mSelectedTargetIndex = 0;
         mActiveEnemyIndex = 0;
         mTimer = 0.0f;
+        mLog.clear();
         if (!mGameState.combatAdvantage) {
             mState = ENEMY_TURN;
-            mLog = "Surprise Attack! Shadows act first.";
+            mLog.message("Surprise Attack! Shadows act first.");
         } else {
             mState = PLAYER_TURN_MAIN; // Player advantage
-            mLog = "Ambush! Phantom Thieves have the advantage.";
+            mLog.message("Ambush! Phantom Thieves have the advantage.");
         }
         // Clear any stale transition request
         mGameState.nextSceneID = -1;
@@ -85,22 +100,11 @@ void CombatScene::initialise() {
         }
 
         // Dynamic encounter generation based on the level that triggered combat
-        mGameState.battleEnemies.clear();
-
-        int levelIdx = mGameState.returnSceneID; // 0: Level 1, 1: Level 2, >=2: Final boss
-        int enemyCount = (levelIdx == 0) ? 2 : 3; // default: L1: 2 enemies, L2: 3 enemies
-
-        // Final level: single boss encounter.
-        if ( levelIdx == 4) {
-            // Final level: single boss encounter
-            Combatant boss = getEnemyData(99);
-            mGameState.battleEnemies.push_back(boss);
-        } else {
-            for (int i = 0; i < enemyCount; ++i) {
-                Combatant enemy = getRandomEnemyForLevel(levelIdx);
-                mGameState.battleEnemies.push_back(enemy);
-            }
-        }
+        mGameState.battleEnemies = rollEncounter(mGameState.returnSceneID, mGameState.rng.encounters);
+        mAI.setCunning(getEnemyCunning(mGameState.returnSceneID));
+        mAI.beginBattle(mGameState.party, mGameState.battleEnemies);
+        mTurn = firstTurn(mGameState.party, mGameState.battleEnemies, mGameState.combatAdvantage);
+        if (mTurn.phase == PHASE_ENEMY) mActiveEnemyIndex = mTurn.slot;
 
         // Assign on-screen positions to avoid overlap in UI
         for (int i = 0; i < (int)mGameState.battleEnemies.size(); ++i) {
@@ -108,24 +112,19 @@ void CombatScene::initialise() {
         }
 
         //  LOAD UI ASSETS
-        mIconAttack = LoadTexture("assets/ui/icon_attack.png");
-        mIconGun    = LoadTexture("assets/ui/icon_gun.png");
-        mIconSkill  = LoadTexture("assets/ui/icon_skill.png");
-        mIconGuard  = LoadTexture("assets/ui/icon_guard.png");
-        mIconItem   = LoadTexture("assets/ui/icon_item.png");
-        mUiCursor   = LoadTexture("assets/ui/ui_cursor.png");
+        mIconAttack = gAssetCache.acquireTexture("assets/ui/icon_attack.png");
+        mIconGun    = gAssetCache.acquireTexture("assets/ui/icon_gun.png");
+        mIconSkill  = gAssetCache.acquireTexture("assets/ui/icon_skill.png");
+        mIconGuard  = gAssetCache.acquireTexture("assets/ui/icon_guard.png");
+        mIconItem   = gAssetCache.acquireTexture("assets/ui/icon_item.png");
+        mUiCursor   = gAssetCache.acquireTexture("assets/ui/ui_cursor.png");
 
         // Initialize Rotation
         mWheelRotation = 0.0f;
         mSelectedActionIndex = 0;
 
         // Ammo reset
-        for (auto& member : mGameState.party) {
-            member.currentAmmo = member.gunWeapon.magazineSize;
-            member.isGuarding = false;
-            member.isDown = false;
-            member.hasActed = false;
-        }
+        prepareParty(mGameState.party);
 
         // Build party entities
         // Clean previous
@@ -158,28 +157,29 @@ void CombatScene::initialise() {
         mGameState.camera.target = { 500.0f, 300.0f }; // Center of screen
 
         // COMBAT MAP SETUP
-        // Build a small arena map using CombatScene::mLevelData
-        if (mGameState.map) { delete mGameState.map; mGameState.map = nullptr; }
-        mGameState.map = new Map(20, 20, mLevelData, "assets/tileset.png", 32.0f, 4, 1, mOrigin);
-        // Reveal entire arena to avoid fog overlay in combat
-        if (mGameState.map) {
+        // Build a small arena map using CombatScene::mLevelData. The arena never
+        // changes, so it is built on the first encounter and reused after that.
+        if (!mGameState.map) {
+            mGameState.map = new Map(20, 20, mLevelData, "assets/tileset.png", 32.0f, 4, 1, mOrigin);
+            // Reveal entire arena to avoid fog overlay in combat
             mGameState.map->revealTiles(mOrigin, 2000.0f);
         }
 
         // Load enemy atlas for combat sprites
-        if (FileExists("assets/enemy_atlas.png")) {
-            mEnemyAtlas = LoadTexture("assets/enemy_atlas.png");
-        } else {
-            mEnemyAtlas = LoadTextureFromImage(GenImageColor(32,25,RED)); // fallback
+        mEnemyAtlas = gAssetCache.acquireTexture("assets/enemy_atlas.png");
+        if (mEnemyAtlas.id == 0) {
+            // Fallback is cached under the atlas path so it is released the same way
+            mEnemyAtlas = gAssetCache.adoptTexture("assets/enemy_atlas.png",
+                LoadTextureFromImage(GenImageColor(32,25,RED)));
         }
 
         //  LOAD SFX
-        mSndMenu = LoadSound("assets/audio/menu.wav");
-        mSndBack = LoadSound("assets/audio/back.wav");
-        mSndGun  = LoadSound("assets/audio/gun.wav");
-        mSndHeal = LoadSound("assets/audio/heal.wav");
-        mSndHit  = LoadSound("assets/audio/hit.wav");
-        mSndCrit = LoadSound("assets/audio/crit.wav");
+        mSndMenu = gAssetCache.acquireSound("assets/audio/menu.wav");
+        mSndBack = gAssetCache.acquireSound("assets/audio/back.wav");
+        mSndGun  = gAssetCache.acquireSound("assets/audio/gun.wav");
+        mSndHeal = gAssetCache.acquireSound("assets/audio/heal.wav");
+        mSndHit  = gAssetCache.acquireSound("assets/audio/hit.wav");
+        mSndCrit = gAssetCache.acquireSound("assets/audio/crit.wav");
         // Apply initial volumes
         if (mSndMenu.frameCount) SetSoundVolume(mSndMenu, gSFXVolume);
         if (mSndBack.frameCount) SetSoundVolume(mSndBack, gSFXVolume);
@@ -190,7 +190,7 @@ void CombatScene::initialise() {
         //  BGM
         {
             if (FileExists("assets/audio/combatmusic.mp3")) {
-                mGameState.bgm = LoadMusicStream("assets/audio/combatmusic.mp3");
+                mGameState.bgm = gAssetCache.acquireMusic("assets/audio/combatmusic.mp3");
                 SetMusicVolume(mGameState.bgm, gMusicVolume);
                 PlayMusicStream(mGameState.bgm);
             }
@@ -202,52 +202,64 @@ void CombatScene::initialise() {
 
 
         // Unload UI Assets
-        UnloadTexture(mIconAttack);
-        UnloadTexture(mIconGun);
-        UnloadTexture(mIconSkill);
-        UnloadTexture(mIconGuard);
-        UnloadTexture(mIconItem);
-        UnloadTexture(mUiCursor);
+        gAssetCache.releaseTexture(mIconAttack);
+        gAssetCache.releaseTexture(mIconGun);
+        gAssetCache.releaseTexture(mIconSkill);
+        gAssetCache.releaseTexture(mIconGuard);
+        gAssetCache.releaseTexture(mIconItem);
+        gAssetCache.releaseTexture(mUiCursor);
         if (mEffects) { delete mEffects; mEffects = nullptr; }
         for (Entity* e : mPartySprites) { delete e; }
         mPartySprites.clear();
         // Unload enemy atlas
-        UnloadTexture(mEnemyAtlas);
-        if (mGameState.bgm.ctxData) { StopMusicStream(mGameState.bgm); UnloadMusicStream(mGameState.bgm); }
+        gAssetCache.releaseTexture(mEnemyAtlas);
+        if (mGameState.bgm.ctxData) {
+            StopMusicStream(mGameState.bgm);
+            gAssetCache.releaseMusic(mGameState.bgm);
+            mGameState.bgm.ctxData = nullptr;
+        }
 
         // Unload SFX
-        if (mSndMenu.frameCount) UnloadSound(mSndMenu);
-        if (mSndBack.frameCount) UnloadSound(mSndBack);
-        if (mSndGun.frameCount)  UnloadSound(mSndGun);
-        if (mSndHeal.frameCount) UnloadSound(mSndHeal);
-        if (mSndHit.frameCount)  UnloadSound(mSndHit);
-        if (mSndCrit.frameCount) UnloadSound(mSndCrit);
+        gAssetCache.releaseSound(mSndMenu);
+        gAssetCache.releaseSound(mSndBack);
+        gAssetCache.releaseSound(mSndGun);
+        gAssetCache.releaseSound(mSndHeal);
+        gAssetCache.releaseSound(mSndHit);
+        gAssetCache.releaseSound(mSndCrit);
     }
 
-    void CombatScene::NextTurn() {
-        bool foundNext = false;
-        // Check for next available party member who hasn't acted
-        for (int i = 0; i < mGameState.party.size(); i++) {
-            if (mGameState.party[i].isAlive && !mGameState.party[i].hasActed) {
-                mActiveMemberIndex = i;
+    void CombatScene::AdvanceTurn() {
+        CombatTurn previous = mTurn;
+        mTurn = advanceTurn(mGameState.party, mGameState.battleEnemies, mTurn, mEvents);
+        PresentTurn(previous);
+    }
+
+    void CombatScene::PresentTurn(CombatTurn previous) {
+        switch (mTurn.phase) {
+            case PHASE_PARTY:
                 mState = PLAYER_TURN_MAIN;
-                // Reset Guard state
-                mGameState.party[i].isGuarding = false;
-                mLog = mGameState.party[i].name + "'s Turn!";
-                foundNext = true;
+                if (previous.phase == PHASE_PARTY && previous.slot == mTurn.slot) {
+                    mLog.message("1 MORE! Go again!");
+                } else {
+                    mActiveMemberIndex = mTurn.slot;
+                    mLog.add(LOG_TURN, partyHandle(mTurn.slot));
+                }
                 break;
-            }
-        }
-        // if none found, switch to enemy turn
-        if (!foundNext) {
-            mState = ENEMY_TURN;
-            mActiveEnemyIndex = 0;
-            mTimer = 0.0f;
-            mLog = "Enemy Turn...";
 
-            for (auto& enemy : mGameState.battleEnemies) {
-                enemy.isDown = false;
-            }
+            case PHASE_HOLD_UP:
+                mState = HOLD_UP;
+                mLog.message("HOLD UP! Press [Y] for All-Out Attack!");
+                break;
+
+            case PHASE_ENEMY:
+                mState = ENEMY_TURN;
+                mActiveEnemyIndex = mTurn.slot;
+                mTimer = 0.0f;
+                mLog.message("Enemy Turn...");
+                break;
+
+            default: // update() shows the outcome
+                break;
         }
     }
 
@@ -260,16 +272,11 @@ void CombatScene::initialise() {
         }
         
         // Check player defeat (Joker at index 0)
-        bool jokerDead = false;
-        if (!mGameState.party.empty()) {
-            jokerDead = !mGameState.party[0].isAlive;
-        }
-
-        bool enemiesAlive = false;
-        for (auto& e : mGameState.battleEnemies) if (e.isAlive) enemiesAlive = true;
+        bool jokerDead = isPartyDefeated(mGameState.party);
+        bool enemiesAlive = anyAlive(mGameState.battleEnemies);
         if (jokerDead) {
-            mLog = "YOU DIED! Press ENTER to return to Title";
-            if (IsKeyPressed(KEY_ENTER)) {
+            mLog.message("YOU DIED! Press ENTER to return to Title");
+            if (gInput.isPressed(KEY_ENTER)) {
                 mGameState.nextSceneID = 3; // Start Menu
             }
             return;
@@ -277,8 +284,8 @@ void CombatScene::initialise() {
         if (!enemiesAlive) {
             // If this combat was triggered from the final level, return to Title
             bool isFinalBossEncounter = (mGameState.returnSceneID == 4);
-            mLog = isFinalBossEncounter ? "YOU WON! Press ENTER to return to Title" : "VICTORY! Press SPACE.";
-            if ((isFinalBossEncounter && IsKeyPressed(KEY_ENTER)) || (!isFinalBossEncounter && IsKeyPressed(KEY_SPACE))) {
+            mLog.message(isFinalBossEncounter ? "YOU WON! Press ENTER to return to Title" : "VICTORY! Press SPACE.");
+            if ((isFinalBossEncounter && gInput.isPressed(KEY_ENTER)) || (!isFinalBossEncounter && gInput.isPressed(KEY_SPACE))) {
                 // Mark the engaged enemy (if valid) as defeated in this scene's state
                 if (mGameState.engagedEnemyIndex >= 0) {
                     if (mGameState.defeatedEnemies.size() <= (size_t)mGameState.engagedEnemyIndex)
@@ -294,53 +301,18 @@ void CombatScene::initialise() {
         if (mState == ANIMATION_WAIT) {
             mTimer += deltaTime;
             if (mTimer > 0.8f) {
-                CheckHoldUp();
-                if (mState != HOLD_UP) {
-                    if (mState != ENEMY_TURN && !mGameState.party[mActiveMemberIndex].hasActed) {
-                            mState = PLAYER_TURN_MAIN;
-                            mLog = "1 MORE! Go again!";
-                        } else {
-                        NextTurn();
-                    }
-                }
+                AdvanceTurn();
                 mTimer = 0.0f;
             }
             return;
         }
 
         if (mState == HOLD_UP) {
-            if (IsKeyPressed(KEY_Y) || IsKeyPressed(KEY_SPACE)) {
-                // Deal 100 damage to all active enemies
-                for (auto& enemy : mGameState.battleEnemies) {
-                    if (!enemy.isAlive) continue;
-                    enemy.currentHp -= 100;
-                    if (enemy.currentHp <= 0) {
-                        enemy.currentHp = 0;
-                        enemy.isAlive = false;
-                    }
-                }
-                // Execute enemies below 50 HP (set to 0 and mark dead)
-                for (auto& enemy : mGameState.battleEnemies) {
-                    if (!enemy.isAlive) continue;
-                    if (enemy.currentHp < 50) {
-                        enemy.currentHp = 0;
-                        enemy.isAlive = false;
-                    }
-                }
-                // Clear downed state on any surviving enemies to prevent immediate re-HOLD UP
-                for (auto& enemy : mGameState.battleEnemies) {
-                    if (enemy.isAlive) enemy.isDown = false;
-                }
-                // Consume current actor's turn if combat is not over
-                bool anyAlive = false;
-                for (auto& e : mGameState.battleEnemies) { if (e.isAlive) { anyAlive = true; break; } }
-
-                mLog = "ALL-OUT ATTACK!";
-                if (anyAlive) {
-                    if (mActiveMemberIndex >= 0 && mActiveMemberIndex < (int)mGameState.party.size()) {
-                        mGameState.party[mActiveMemberIndex].hasActed = true;
-                    }
-                }
+            if (gInput.isPressed(KEY_Y) || gInput.isPressed(KEY_SPACE)) {
+                CombatAction allOut(ACTION_ALL_OUT);
+                allOut.actor = partyHandle(mActiveMemberIndex);
+                Resolve(allOut);
+                mLog.message("ALL-OUT ATTACK!");
                 mState = ANIMATION_WAIT;
                 mTimer = 0.0f;
             }
@@ -350,36 +322,22 @@ void CombatScene::initialise() {
         if (mState == ENEMY_TURN) {
             mTimer += deltaTime;
             if (mTimer > 1.0f) {
-                while (mActiveEnemyIndex < mGameState.battleEnemies.size() && !mGameState.battleEnemies[mActiveEnemyIndex].isAlive) {
-                    mActiveEnemyIndex++;
-                }
-
-                if (mActiveEnemyIndex < mGameState.battleEnemies.size()) {
-                    Combatant& enemy = mGameState.battleEnemies[mActiveEnemyIndex];
-                    int partySize = (int)mGameState.party.size();
-                    if (partySize > 0) {
-                        int targetID = GetRandomValue(0, partySize - 1);
-                        if (mGameState.party[targetID].isAlive) {
-                            mGameState.party[targetID].currentHp -= enemy.baseAttack;
-                            if (mGameState.party[targetID].currentHp <= 0) {
-                                mGameState.party[targetID].currentHp = 0;
-                                mGameState.party[targetID].isAlive = false;
-                            }
-                            if (mSndHit.frameCount) { SetSoundVolume(mSndHit, gSFXVolume); PlaySound(mSndHit); }
-                            mLog = enemy.name + " attacks " + mGameState.party[targetID].name + "!";
-                            // Spawn damage number near target ally
-                            float tx = 100.0f; // left HUD base
-                            float ty = 100.0f + (targetID * 90.0f);
-                            SpawnFloatingText({ tx + 220.0f, ty }, TextFormat("-%d", enemy.baseAttack), RED, 0.8f);
-                        }
+                if (mTurn.phase == PHASE_ENEMY) {
+                    CombatAction attack;
+                    {
+                        PROFILE_SCOPE(PROFILE_AI);
+                        attack = mAI.chooseAction(mGameState.party, mGameState.battleEnemies, mTurn.slot, mGameState.rng.combat);
                     }
+                    Resolve(attack);
 
-                    mActiveEnemyIndex++;
+                    // The next enemy attacks after the same pause; the party's
+                    // turn is shown once the last one has
+                    mTurn = advanceTurn(mGameState.party, mGameState.battleEnemies, mTurn, mEvents);
+                    mActiveEnemyIndex = mTurn.phase == PHASE_ENEMY ? mTurn.slot : (int)mGameState.battleEnemies.size();
                     mTimer = 0.0f;
                 } else {
-                    for (auto& p : mGameState.party) p.hasActed = false;
-                    mState = PLAYER_TURN_MAIN;
-                    NextTurn();
+                    CombatTurn enemyTurn = { PHASE_ENEMY, mActiveEnemyIndex };
+                    PresentTurn(enemyTurn);
                 }
             }
             return;
@@ -389,17 +347,18 @@ void CombatScene::initialise() {
         // Dead allies cannot act: skip their turn automatically
         if (!actor.isAlive) {
             actor.hasActed = true;
-            NextTurn();
+            mEvents.clear();
+            AdvanceTurn();
             return;
         }
 
         if (mState == PLAYER_TURN_MAIN) {
             // Command Wheel rotation via UP/DOWN
-            if (IsKeyPressed(KEY_DOWN)) {
+            if (gInput.isPressed(KEY_DOWN)) {
                 mSelectedActionIndex = (mSelectedActionIndex + 1) % 5;
                 if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); }
             }
-            else if (IsKeyPressed(KEY_UP)) {
+            else if (gInput.isPressed(KEY_UP)) {
                 mSelectedActionIndex = (mSelectedActionIndex - 1 + 5) % 5;
                 if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); }
             }
@@ -412,7 +371,7 @@ void CombatScene::initialise() {
             mWheelRotation = Lerp(mWheelRotation, targetRot, 10.0f * deltaTime);
 
             // Confirm selection
-            if (IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_Z)) {
+            if (gInput.isPressed(KEY_SPACE) || gInput.isPressed(KEY_Z)) {
                 if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); }
                 switch (mSelectedActionIndex) {
                     case 0: { // Attack
@@ -427,10 +386,10 @@ void CombatScene::initialise() {
                         if (actor.currentAmmo > 0) {
                             mState = PLAYER_TURN_TARGET;
                             mSelectedSkillIndex = -2; // Gun indicator
-                            mLog = "Ammo left: " + std::to_string(actor.currentAmmo) + " / " + std::to_string(actor.gunWeapon.magazineSize);
+                            mLog.add(LOG_AMMO, partyHandle(mActiveMemberIndex), NO_COMBATANT, actor.currentAmmo);
                         }
                         else {
-                            mLog = "Out of Ammo!";
+                            mLog.message("Out of Ammo!");
                         }
                         break;
                     }
@@ -440,9 +399,9 @@ void CombatScene::initialise() {
                         break;
                     }
                     case 3: { // Guard
-                        actor.isGuarding = true;
-                        mLog = actor.name + " is Guarding...";
-                        actor.hasActed = true;
+                        CombatAction guard(ACTION_GUARD);
+                        guard.actor = partyHandle(mActiveMemberIndex);
+                        Resolve(guard);
                         mState = ANIMATION_WAIT;
                         mTimer = 0.0f;
                         break;
@@ -452,17 +411,17 @@ void CombatScene::initialise() {
                             mState = PLAYER_TURN_ITEM;
                             mSelectedSkillIndex = 0; // Reuse skill index for item selection
                         } else {
-                            mLog = "No items!";
+                            mLog.message("No items!");
                         }
                         break;
                     }
                 }
             }
         } else if (mState == PLAYER_TURN_SKILLS) {
-            if (IsKeyPressed(KEY_DOWN)) { mSelectedSkillIndex = (mSelectedSkillIndex + 1) % actor.skills.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
-            else if (IsKeyPressed(KEY_UP)) { mSelectedSkillIndex = (mSelectedSkillIndex - 1 + actor.skills.size()) % actor.skills.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
+            if (gInput.isPressed(KEY_DOWN)) { mSelectedSkillIndex = (mSelectedSkillIndex + 1) % actor.skills.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
+            else if (gInput.isPressed(KEY_UP)) { mSelectedSkillIndex = (mSelectedSkillIndex - 1 + actor.skills.size()) % actor.skills.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
 
-            if (IsKeyPressed(KEY_Z ) || IsKeyPressed(KEY_SPACE)) {
+            if (gInput.isPressed(KEY_Z ) || gInput.isPressed(KEY_SPACE)) {
                 if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); }
                 Ability chosenSkill = actor.skills[mSelectedSkillIndex];
                 if (chosenSkill.damage < 0) {
@@ -476,107 +435,67 @@ void CombatScene::initialise() {
                     }
                     mState = PLAYER_TURN_TARGET;
                 }
-            } else if (IsKeyPressed(KEY_C) || IsKeyPressed(KEY_ESCAPE)) { if (mSndBack.frameCount) { SetSoundVolume(mSndBack, gSFXVolume); PlaySound(mSndBack); } mState = PLAYER_TURN_MAIN; }
+            } else if (gInput.isPressed(KEY_C) || gInput.isPressed(KEY_ESCAPE)) { if (mSndBack.frameCount) { SetSoundVolume(mSndBack, gSFXVolume); PlaySound(mSndBack); } mState = PLAYER_TURN_MAIN; }
         } else if (mState == PLAYER_TURN_TARGET) {
-            if (IsKeyPressed(KEY_RIGHT)) { mSelectedTargetIndex = (mSelectedTargetIndex + 1) % mGameState.battleEnemies.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
-            else if (IsKeyPressed(KEY_LEFT)) { mSelectedTargetIndex = (mSelectedTargetIndex - 1 + mGameState.battleEnemies.size()) % mGameState.battleEnemies.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
+            if (gInput.isPressed(KEY_RIGHT)) { mSelectedTargetIndex = (mSelectedTargetIndex + 1) % mGameState.battleEnemies.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
+            else if (gInput.isPressed(KEY_LEFT)) { mSelectedTargetIndex = (mSelectedTargetIndex - 1 + mGameState.battleEnemies.size()) % mGameState.battleEnemies.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
 
             while (!mGameState.battleEnemies[mSelectedTargetIndex].isAlive) {
                 mSelectedTargetIndex = (mSelectedTargetIndex + 1) % mGameState.battleEnemies.size();
             }
 
-            if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
-                Ability action;
-                bool isGunAction = false;
-                if (mSelectedSkillIndex == -1) {
-                    action = {"Melee", 0, 0, PHYS, false};
-                }
-                else if (mSelectedSkillIndex == -2) {
-                    action = {"Gun", 0, 0, GUN, false};
-                    isGunAction = true;
-                    if (actor.currentAmmo > 0) {
-                        actor.currentAmmo--;
-                    }
-                }
-                else {
-                    action = actor.skills[mSelectedSkillIndex];
-                    if (action.isMagic) actor.currentSp -= action.cost;
-                    else actor.currentHp -= action.cost;
-                }
-                // Play gun shot immediately for gun action
-                if (isGunAction && mSndGun.frameCount) { SetSoundVolume(mSndGun, gSFXVolume); PlaySound(mSndGun); }
-                CheckWeakness(actor, mGameState.battleEnemies[mSelectedTargetIndex], action);
-                // Allow multiple gun shots in a single turn until ammo is 0
-                if (isGunAction && actor.currentAmmo > 0) {
-                    actor.hasActed = false; // keep turn
-                    mState = PLAYER_TURN_TARGET; // remain in target selection
-                    mLog = "Ammo left: " + std::to_string(actor.currentAmmo) + " / " + std::to_string(actor.gunWeapon.magazineSize);
-                    mTimer = 0.0f; // cancel wait animation for rapid fire
-                }
-            } else if (IsKeyPressed(KEY_C) || IsKeyPressed(KEY_ESCAPE)) { if (mSndBack.frameCount) { SetSoundVolume(mSndBack, gSFXVolume); PlaySound(mSndBack); } mState = PLAYER_TURN_MAIN; }
+            if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
+                CombatAction attack(ACTION_SKILL);
+                if (mSelectedSkillIndex == -1) attack.type = ACTION_MELEE;
+                else if (mSelectedSkillIndex == -2) attack.type = ACTION_GUN;
+                else attack.skill = mSelectedSkillIndex;
+                attack.actor  = partyHandle(mActiveMemberIndex);
+                attack.target = enemyHandle(mSelectedTargetIndex);
+                Resolve(attack);
+
+                // Allow multiple gun shots in a single turn until ammo is 0:
+                // remain in target selection
+                if (!mEvents.contains(EVENT_RAPID_FIRE)) mState = ANIMATION_WAIT;
+                mTimer = 0.0f;
+            } else if (gInput.isPressed(KEY_C) || gInput.isPressed(KEY_ESCAPE)) { if (mSndBack.frameCount) { SetSoundVolume(mSndBack, gSFXVolume); PlaySound(mSndBack); } mState = PLAYER_TURN_MAIN; }
         }
         else if (mState == PLAYER_TURN_TARGET_ALLY) 
         {
             // 1. Navigate Party List (Up/Down matches the visual layout)
-            if (IsKeyPressed(KEY_DOWN)) { mSelectedTargetIndex = (mSelectedTargetIndex + 1) % mGameState.party.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
-            else if (IsKeyPressed(KEY_UP)) { mSelectedTargetIndex = (mSelectedTargetIndex - 1 + mGameState.party.size()) % mGameState.party.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
+            if (gInput.isPressed(KEY_DOWN)) { mSelectedTargetIndex = (mSelectedTargetIndex + 1) % mGameState.party.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
+            else if (gInput.isPressed(KEY_UP)) { mSelectedTargetIndex = (mSelectedTargetIndex - 1 + mGameState.party.size()) % mGameState.party.size(); if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); } }
 
-            if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) // CONFIRM HEAL
+            if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) // CONFIRM HEAL
             {
-                Combatant& actor = mGameState.party[mActiveMemberIndex];
-                Combatant& target = mGameState.party[mSelectedTargetIndex];
-
                 if (mSelectedSkillIndex <= -100) {
                     // Using an item: decode item index from sentinel
                     int itemIndex = -mSelectedSkillIndex - 100;
                     if (itemIndex >= 0 && itemIndex < (int)mGameState.inventory.size()) {
-                        Item item = mGameState.inventory[itemIndex];
-                        if (item.isRevive) {
-                            if (!target.isAlive) {
-                                target.isAlive = true;
-                                target.isDown = false;
-                                target.currentHp = item.value;
-                                if (target.currentHp > target.maxHp) target.currentHp = target.maxHp;
-                                mLog = "Revived " + target.name + " to " + std::to_string(target.currentHp) + " HP!";
-                            } else {
-                                mLog = target.name + " is already alive.";
-                            }
-                        } else if (item.isSP) {
-                            target.currentSp += item.value;
-                            if (target.currentSp > target.maxSp) target.currentSp = target.maxSp;
-                            mLog = "Restored " + std::to_string(item.value) + " SP to " + target.name + "!";
-                        } else {
-                            target.currentHp += item.value;
-                            if (target.currentHp > target.maxHp) target.currentHp = target.maxHp;
-                            mLog = "Healed " + target.name + " for " + std::to_string(item.value) + " HP!";
-                        }
+                        CombatAction use(ACTION_ITEM);
+                        use.actor  = partyHandle(mActiveMemberIndex);
+                        use.target = partyHandle(mSelectedTargetIndex);
+                        use.item   = &mGameState.inventory[itemIndex];
+                        Resolve(use);
                         // Consume item
                         mGameState.inventory.erase(mGameState.inventory.begin() + itemIndex);
-                        actor.hasActed = true;
-                        // heal item sfx
-                        if (mSndHeal.frameCount) { SetSoundVolume(mSndHeal, gSFXVolume); PlaySound(mSndHeal); }
                         mState = ANIMATION_WAIT;
                         mTimer = 0.0f;
                     } else {
-                        mLog = "Item use canceled.";
+                        mLog.message("Item use canceled.");
                         mState = PLAYER_TURN_ITEM;
                     }
                 } else {
                     // Using a healing skill
-                    Ability& skill = actor.skills[mSelectedSkillIndex];
-                    if (skill.isMagic) actor.currentSp -= skill.cost;
-                    else actor.currentHp -= skill.cost;
-                    int healAmount = -skill.damage; 
-                    target.currentHp += healAmount;
-                    if (target.currentHp > target.maxHp) target.currentHp = target.maxHp;
-                    mLog = "Healed " + target.name + " for " + std::to_string(healAmount) + " HP!";
-                    if (mSndHeal.frameCount) { SetSoundVolume(mSndHeal, gSFXVolume); PlaySound(mSndHeal); }
-                    actor.hasActed = true;
+                    CombatAction heal(ACTION_SKILL);
+                    heal.actor  = partyHandle(mActiveMemberIndex);
+                    heal.target = partyHandle(mSelectedTargetIndex);
+                    heal.skill  = mSelectedSkillIndex;
+                    Resolve(heal);
                     mState = ANIMATION_WAIT;
                     mTimer = 0.0f;
                 }
             }
-            else if (IsKeyPressed(KEY_C) || IsKeyPressed(KEY_ESCAPE)) 
+            else if (gInput.isPressed(KEY_C) || gInput.isPressed(KEY_ESCAPE)) 
             {
                 // Return to correct menu based on origin
                 if (mSelectedSkillIndex <= -100) {
@@ -592,20 +511,20 @@ void CombatScene::initialise() {
         }
         else if (mState == PLAYER_TURN_ITEM) 
         {
-            if (IsKeyPressed(KEY_DOWN)) { 
+            if (gInput.isPressed(KEY_DOWN)) { 
                 mSelectedSkillIndex = (mSelectedSkillIndex + 1) % mGameState.inventory.size();
                 if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); }
             }
-            if (IsKeyPressed(KEY_UP))   {
+            if (gInput.isPressed(KEY_UP))   {
                 mSelectedSkillIndex = (mSelectedSkillIndex - 1 + mGameState.inventory.size()) % mGameState.inventory.size();
                 if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); }
             }
-            if (IsKeyPressed(KEY_C) || IsKeyPressed(KEY_ESCAPE)) { 
+            if (gInput.isPressed(KEY_C) || gInput.isPressed(KEY_ESCAPE)) { 
                 if (mSndBack.frameCount) { SetSoundVolume(mSndBack, gSFXVolume); PlaySound(mSndBack); }
                 mState = PLAYER_TURN_MAIN; // Cancel back to main
             }
             // Use Item
-            if (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_SPACE)) {
+            if (gInput.isPressed(KEY_Z) || gInput.isPressed(KEY_SPACE)) {
                 if (mSndMenu.frameCount) { SetSoundVolume(mSndMenu, gSFXVolume); PlaySound(mSndMenu); }
                 // Encode the selected item into a negative sentinel to distinguish later
                 mSelectedSkillIndex = -(100 + mSelectedSkillIndex);
@@ -625,82 +544,68 @@ void CombatScene::initialise() {
         }
     }
 
-    void CombatScene::CheckWeakness(Combatant& attacker, Combatant& defender, Ability skill) {
-        bool isWeakness = false;
-        if (!defender.isGuarding) {
-            for (Element w : defender.weaknesses) {
-                if (skill.element == w) { isWeakness = true; break; }
-            }
-        }
-
-        // calculate damage
-        int attatckPower = skill.damage;
-        
-        // if melee or gun, factor in attacker's stats
-        if (skill.element == PHYS) {
-            attatckPower += attacker.getTotalAttack();
-        } else if (skill.element == GUN) {
-            attatckPower += attacker.getTotalGunAttack();
-        }
-
-        int damage = attatckPower - defender.getTotalDefense();
-        if (damage < 1) damage = 1; // Minimum damage
-        // apply modifiers
-        if (isWeakness) damage = (int)(damage * 1.5f);
-        if (defender.isGuarding) damage = (int) (damage * 0.5f);
-
-        // apply damage
-        defender.currentHp -= damage;
-        if (defender.currentHp <= 0) {
-            defender.currentHp = 0;
-            defender.isAlive = false;
-            defender.isDown = true;
-        }
-        // Play impact SFX (crit for weakness, otherwise hit)
-        if (isWeakness) {
-            if (mSndCrit.frameCount) { SetSoundVolume(mSndCrit, gSFXVolume); PlaySound(mSndCrit); }
-        } else {
-            if (mSndHit.frameCount) { SetSoundVolume(mSndHit, gSFXVolume); PlaySound(mSndHit); }
-        }
-
-        // One more mechanics
-        if (isWeakness && !defender.isDown && defender.isAlive) {
-            defender.isDown = true;
-            mLog = "WEAKNESS! 1 More!";
-            attacker.hasActed = false;
-        } else {
-            mLog = "Hit! Dealt " + std::to_string(damage) + " damage.";
-            attacker.hasActed = true;
-        }
-        // Spawn damage floating text at enemy position
-        // Find index of defender in enemy list if present
-        int defIndex = -1;
-        for (int i = 0; i < (int)mGameState.battleEnemies.size(); ++i) {
-            if (mGameState.battleEnemies[i].name == defender.name) { defIndex = i; break; }
-        }
-        if (defIndex >= 0) {
-            float ex = 600.0f + (defIndex * 120.0f);
-            float ey = 200.0f;
-            SpawnFloatingText({ ex + 10.0f, ey - 40.0f }, TextFormat("-%d", damage), YELLOW, 0.8f);
-        }
-
-        mState = ANIMATION_WAIT;
-        mTimer = 0.0f;
+    void CombatScene::Resolve(const CombatAction& action) {
+        resolveAction(mGameState.party, mGameState.battleEnemies, action, mEvents);
+        applyEvents(mGameState.party, mGameState.battleEnemies, mEvents);
+        PresentEvents(mEvents);
     }
 
-    void CombatScene::CheckHoldUp() {
-        bool allDown = true;
-        bool anyAlive = false;
-        for (auto& enemy : mGameState.battleEnemies) {
-            if (enemy.isAlive) {
-                anyAlive = true;
-                if (!enemy.isDown) allDown = false;
+    // Log line, sounds and floating numbers for what an action did. Runs after
+    // the events are applied, so combatants already show the outcome.
+    void CombatScene::PresentEvents(const CombatEvents& events) {
+        for (int i = 0; i < events.count; i++) {
+            const CombatEvent& event = events[i];
+
+            switch (event.type) {
+                case EVENT_SHOT:
+                    if (mSndGun.frameCount) { SetSoundVolume(mSndGun, gSFXVolume); PlaySound(mSndGun); }
+                    break;
+
+                case EVENT_DAMAGE:
+                    if (isEnemyHandle(event.actor)) {
+                        if (mSndHit.frameCount) { SetSoundVolume(mSndHit, gSFXVolume); PlaySound(mSndHit); }
+                        mLog.add(LOG_ENEMY_ATTACK, event.actor, event.target);
+                        // Spawn damage number near target ally
+                        float tx = 100.0f; // left HUD base
+                        float ty = 100.0f + (handleSlot(event.target) * 90.0f);
+                        SpawnFloatingText({ tx + 220.0f, ty }, event.amount, RED, 0.8f);
+                        break;
+                    }
+                    // Play impact SFX (crit for weakness, otherwise hit)
+                    if (event.isWeakness) {
+                        if (mSndCrit.frameCount) { SetSoundVolume(mSndCrit, gSFXVolume); PlaySound(mSndCrit); }
+                    } else {
+                        if (mSndHit.frameCount) { SetSoundVolume(mSndHit, gSFXVolume); PlaySound(mSndHit); }
+                    }
+                    mLog.add(LOG_HIT, event.actor, event.target, event.amount);
+                    {
+                        // Spawn damage floating text at enemy position
+                        float ex = 600.0f + (handleSlot(event.target) * 120.0f);
+                        float ey = 200.0f;
+                        SpawnFloatingText({ ex + 10.0f, ey - 40.0f }, event.amount, YELLOW, 0.8f);
+                    }
+                    break;
+
+                case EVENT_ONE_MORE:   mLog.add(LOG_ONE_MORE, event.actor); break;
+                case EVENT_RAPID_FIRE: mLog.add(LOG_AMMO, event.actor, NO_COMBATANT, event.amount); break;
+                case EVENT_GUARD:      mLog.add(LOG_GUARD, event.actor); break;
+
+                case EVENT_HEAL:
+                case EVENT_RESTORE_SP:
+                case EVENT_REVIVE:
+                case EVENT_NO_EFFECT: {
+                    BattleLogType type = event.type == EVENT_HEAL ? LOG_HEAL
+                                       : event.type == EVENT_RESTORE_SP ? LOG_RESTORE_SP
+                                       : event.type == EVENT_REVIVE ? LOG_REVIVE : LOG_NO_EFFECT;
+                    mLog.add(type, event.actor, event.target, event.amount);
+                    if (mSndHeal.frameCount) { SetSoundVolume(mSndHeal, gSFXVolume); PlaySound(mSndHeal); }
+                    break;
+                }
+
+                default:
+                    break;
             }
         }
-        if (anyAlive && allDown) {
-            mState = HOLD_UP;
-            mLog = "HOLD UP! Press [Y] for All-Out Attack!";
-        }
     }
 
     void CombatScene::render() {
@@ -840,7 +745,7 @@ void CombatScene::initialise() {
         // Bottom UI Panel for mLog
         DrawRectangle(500, 500, 500, 100, Fade(DARKGRAY, 0.85f));
         DrawRectangleLines(500, 500, 500, 100, WHITE);
-        DrawText(mLog.c_str(), 520, 510, 20, WHITE);
+        DrawText(mLog.latest(mGameState.party, mGameState.battleEnemies), 520, 510, 20, WHITE);
 
         // Context-aware control & action hints
         Combatant& actor = mGameState.party[mActiveMemberIndex];
@@ -1019,7 +924,7 @@ void CombatScene::initialise() {
         for (const FloatingText& ft : mFloatingTexts) {
             float alpha = 1.0f - (ft.elapsed / ft.lifetime);
             Color c = ft.color; c.a = (unsigned char)(alpha * 255);
-            DrawText(ft.text.c_str(), (int)ft.pos.x, (int)ft.pos.y, 20, c);
+            DrawText(TextFormat("-%d", ft.damage), (int)ft.pos.x, (int)ft.pos.y, 20, c);
         }
         // --- RENDER EFFECT OVERLAY ---
         if (mEffects) mEffects->render();
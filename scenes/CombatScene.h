@@ -4,6 +4,9 @@
 #include "../lib/Scene.h"
 #include "../lib/GameTypes.h"
 #include "../lib/Entity.h"
+#include "../lib/CombatRules.h"
+#include "../lib/BattleLog.h"
+#include "../lib/CombatAI.h"
 #include <vector>
 #include <string>
 
@@ -31,19 +34,28 @@ public:
     void update(float deltaTime) override;
     void render() override;
     void shutdown() override;
+    const AssetManifest &getAssetManifest() const override;
 
 private:
-    void NextTurn();
-    void CheckWeakness(Combatant& attacker, Combatant& defender, Ability skill);
-    void CheckHoldUp();
+    // Moves on to whoever the combat rules say acts after the last action
+    void AdvanceTurn();
+    // Menus and log line for mTurn, which came after `previous`
+    void PresentTurn(CombatTurn previous);
+    // Resolves an action, applies it and presents what happened
+    void Resolve(const CombatAction& action);
+    void PresentEvents(const CombatEvents& events);
 
     // UI State
     CombatState mState;
-    std::string mLog;
+    BattleLog mLog;
     float mTimer;
 
     int mActiveMemberIndex = 0;
     int mActiveEnemyIndex = 0;
+    CombatTurn mTurn = { PHASE_PARTY, 0 }; // whose move it is
+
+    CombatEvents mEvents; // the last resolved action
+    CombatAI     mAI;     // picks the enemies' actions
     
     // Selection Indices
     int mSelectedSkillIndex = 0;
@@ -77,13 +89,13 @@ private:
     // DAMAGE FLOATING TEXT 
     struct FloatingText {
         Vector2 pos;
-        std::string text;
+        int damage;
         Color color;
         float lifetime;   // seconds remaining
         float elapsed;    // seconds elapsed
     };
     std::vector<FloatingText> mFloatingTexts;
-    void SpawnFloatingText(Vector2 pos, const std::string& text, Color color, float lifetime = 0.8f);
+    void SpawnFloatingText(Vector2 pos, int damage, Color color, float lifetime = 0.8f);
 
     // AUDIO SFX 
     Sound mSndMenu = {};
@@ -1,6 +1,8 @@
 #include "LevelOne.h"
 #include "../lib/Effects.h" // Include full definition here
 #include "../lib/GameData.h" // Loot helpers
+#include "../lib/Input.h"
+#include "../lib/Profiler.h"
 #include <cmath> // atan2f for debug cone rendering
 extern float gMusicVolume;
 
@@ -8,6 +10,15 @@ extern float gMusicVolume;
 // Defeated enemies are tracked per scene in mGameState.defeatedEnemies now.
 extern int gCurrentLevelIndex; // used to set returnSceneID during combat transitions
 
+// Everything this scene loads, kept resident between visits
+static const AssetManifest LEVEL_ONE_ASSETS = {
+    { "assets/tileset.png", "assets/characters.png", "assets/enemy_atlas.png", "assets/chest.png" },
+    { },
+    { "assets/audio/levelmusic.mp3" }
+};
+
+const AssetManifest &LevelOne::getAssetManifest() const { return LEVEL_ONE_ASSETS; }
+
 void LevelOne::initialise()
 {
     mGameState.nextSceneID = -1;
@@ -27,12 +38,10 @@ void LevelOne::initialise()
     // Clean previous props array
     if (mWorldProps) { delete[] mWorldProps; mWorldProps = nullptr; mPropCount = 0; }
 
-    // 1. LOAD MAP (only allocate once; recreate each initialise for simplicity)
-    if (mGameState.map) {
-        delete mGameState.map;
-        mGameState.map = nullptr;
+    // 1. LOAD MAP (only allocate once; the layout is static so re-entry reuses it)
+    if (!mGameState.map) {
+        mGameState.map = new Map(50, 50, mLevelData, "assets/tileset.png", 32.0f, 4, 1, mOrigin);
     }
-    mGameState.map = new Map(50, 50, mLevelData, "assets/tileset.png", 32.0f, 4, 1, mOrigin);
 
     // 1b. DEFINE WALKING ANIMATION ATLAS (5 cols x 4 rows)
     std::map<Direction, std::vector<int>> walkingAnimation = {
@@ -135,7 +144,6 @@ void LevelOne::initialise()
     if (mGameState.enemyCount > 0) {
         mGameState.worldEnemies = new Entity[mGameState.enemyCount];
         for (size_t i = 0; i < guardPositions.size(); ++i) {
-            mGameState.worldEnemies[i] = Entity();
             mGameState.worldEnemies[i].setPosition(guardPositions[i]);
             mGameState.worldEnemies[i].setScale({ 32.0f, 32.0f });
             mGameState.worldEnemies[i].setColliderDimensions({ 32.0f, 32.0f });
@@ -200,7 +208,6 @@ void LevelOne::initialise()
     for (size_t i = 0; i < chestPositions.size(); ++i) {
         if (mGameState.openedChests[i]) continue; // Skip spawning opened chests
 
-        mWorldProps[propIndex] = Entity();
         mWorldProps[propIndex].setEntityType(PROP);
         mWorldProps[propIndex].setIsChest(true);
         mWorldProps[propIndex].setPosition(chestPositions[i]);
@@ -213,15 +220,24 @@ void LevelOne::initialise()
         ++propIndex;
     }
 
+    // Broadphase: chests never move, so their grid is built once per visit
+    float cellSize = mGameState.map ? mGameState.map->getTileSize() * 2.0f : 64.0f;
+    mPropGrid.setCellSize(cellSize);
+    mFollowerGrid.setCellSize(cellSize);
+    mEnemyGrid.setCellSize(cellSize);
+    mAIScheduler.reset(mGameState.enemyCount);
+    mPropGrid.clear();
+    for (int i = 0; i < mPropCount; ++i) mPropGrid.insert(&mWorldProps[i]);
+
     // SETUP CAMERA
     mGameState.camera.target = mGameState.player->getPosition();
     mGameState.camera.offset = mOrigin;
     mGameState.camera.rotation = 0.0f;
     mGameState.camera.zoom = 2.0f;
 
-    // If we have a saved exploration buffer for this map, restore it
-    if (mGameState.map && !mGameState.revealedTiles.empty()) {
-        mGameState.map->setExploredTiles(mGameState.revealedTiles);
+    // Exploration is written straight into the persisted buffer (restoring any saved progress)
+    if (mGameState.map) {
+        mGameState.map->attachExploredTiles(&mGameState.revealedTiles);
     }
 
     // Initialize Effects with screen dimensions (1000x600)
@@ -232,8 +248,8 @@ void LevelOne::initialise()
     mIsTransitioning = false;
 
     // BGM
-    if (mGameState.bgm.ctxData) { StopMusicStream(mGameState.bgm); UnloadMusicStream(mGameState.bgm); }
-    mGameState.bgm = LoadMusicStream("assets/audio/levelmusic.mp3");
+    if (mGameState.bgm.ctxData) { StopMusicStream(mGameState.bgm); gAssetCache.releaseMusic(mGameState.bgm); }
+    mGameState.bgm = gAssetCache.acquireMusic("assets/audio/levelmusic.mp3");
     SetMusicVolume(mGameState.bgm, gMusicVolume);
     PlayMusicStream(mGameState.bgm);
 
@@ -242,7 +258,11 @@ void LevelOne::initialise()
 void LevelOne::update(float deltaTime)
 {
     // Keep exploration music streaming
-    if (mGameState.bgm.ctxData) { SetMusicVolume(mGameState.bgm, gMusicVolume); UpdateMusicStream(mGameState.bgm); }
+    if (mGameState.bgm.ctxData) {
+        PROFILE_SCOPE(PROFILE_AUDIO);
+        SetMusicVolume(mGameState.bgm, gMusicVolume);
+        UpdateMusicStream(mGameState.bgm);
+    }
     // HANDLE TRANSITION SEQUENCE
     if (mIsTransitioning)
     {
@@ -263,13 +283,12 @@ void LevelOne::update(float deltaTime)
     }
 
     // PLAYER UPDATE & MAP INTERACTION
-    mGameState.player->update(deltaTime, mGameState.player, mGameState.map, mWorldProps, mPropCount);
-    // reveal tiles around player and persist exploration
+    mGameState.player->update(deltaTime, mGameState.player, mGameState.map, &mPropGrid);
+    // reveal tiles around player (persisted via the attached revealedTiles buffer)
     if (mGameState.map && mGameState.player)
     {
         Vector2 pPos = mGameState.player->getPosition();
         mGameState.map->revealTiles(pPos, 200.0f);
-        mGameState.revealedTiles = mGameState.map->getExploredTiles();
     }
 
     // FOLLOWER PARTY PHYSICS
@@ -277,29 +296,31 @@ void LevelOne::update(float deltaTime)
     constexpr float REPEL_STRENGTH  = 20000.0f;
     constexpr float JITTER_STRENGTH = 5.0f;
     constexpr float DAMPING         = 0.90f;
+    mFollowerGrid.clear();
+    for (Entity* f : mFollowers) mFollowerGrid.insert(f);
     for (Entity* f : mFollowers) {
         if (!f) continue;
-        f->updateFollowerPhysics(mGameState.player, mFollowers, mGameState.map, deltaTime,
-            TETHER_SPEED, REPEL_STRENGTH, JITTER_STRENGTH, DAMPING);
+        f->updateFollowerPhysics(mGameState.player, &mFollowerGrid, mGameState.map, deltaTime,
+            TETHER_SPEED, REPEL_STRENGTH, JITTER_STRENGTH, DAMPING, mGameState.rng.jitter);
     }
 
     // STEALTH / DETECTION CONSTANTS 
     const float AMBUSH_DISTANCE = 60.0f; // Close range for back attack
-    const float SIGHT_DISTANCE  = 100.0f;
-    const float SIGHT_ANGLE     = 90.0f; // Full cone angle
     bool isSpotted = false; // Aggregate spotted state (for shader/effects)
 
     // PROP INTERACTION (CHESTS) ---
-    if (IsKeyPressed(KEY_SPACE)) {
+    if (gInput.isPressed(KEY_SPACE)) {
         Entity* player = mGameState.player;
-        for (int i = 0; i < mPropCount; ++i) {
-            Entity* prop = &mWorldProps[i];
+        mNearby.clear();
+        mPropGrid.queryRadius(player->getPosition(), 50.0f, mNearby);
+        for (Entity* prop : mNearby) {
+            int i = (int)(prop - mWorldProps);
             if (!prop->isActive() || !prop->isChest()) continue;
             float dist = Vector2Distance(player->getPosition(), prop->getPosition());
             if (dist < 50.0f) {
                 // Use player's sight cone to validate facing the chest
                 if (player->isEntityInSight(prop, 60.0f, 60.0f)) {
-                    Item loot = getRandomChestItem(0);
+                    Item loot = getRandomChestItem(0, mGameState.rng.loot);
                     mGameState.inventory.push_back(loot);
                     // Set global toast notification (2 seconds)
                     mGameState.itemToast = std::string("Obtained: ") + loot.name;
@@ -327,36 +348,49 @@ void LevelOne::update(float deltaTime)
     }
     
 
-    //  ENEMY UPDATE & COMBAT TRIGGERS 
+    //  ENEMY UPDATE 
+    Entity* player = mGameState.player;
+    // Perception first (rate-limited per enemy), so the AI and the detection
+    // pass below read the same answer
+    {
+        PROFILE_SCOPE(PROFILE_AI);
+        mAIScheduler.update(mGameState.worldEnemies, mGameState.enemyCount, player, mGameState.map, deltaTime);
+        for (int i = 0; i < mGameState.enemyCount; i++)
+        {
+            mGameState.worldEnemies[i].update(deltaTime, player, mGameState.map, NULL, 0);
+        }
+    }
+    mEnemyGrid.clear();
     for (int i = 0; i < mGameState.enemyCount; i++)
     {
-        Entity* enemy  = &mGameState.worldEnemies[i];
-        Entity* player = mGameState.player;
+        if (mGameState.worldEnemies[i].isActive()) mEnemyGrid.insert(&mGameState.worldEnemies[i]);
+    }
 
-        enemy->update(deltaTime, player, mGameState.map, NULL, 0);
+    //  DETECTION (perception cached by the scheduler this tick)
+    for (int i = 0; i < mGameState.enemyCount; i++)
+    {
+        Entity* enemy = &mGameState.worldEnemies[i];
         if (!enemy->isActive()) continue;
 
-        // Detection (view cone)
-        bool inSight = enemy->isEntityInSight(player, SIGHT_DISTANCE, SIGHT_ANGLE);
-        if (inSight && mGameState.map) {
-             if (!mGameState.map->hasLineOfSight(enemy->getPosition(), player->getPosition())) {
-                 inSight = false;
-             }
-        }
-        if (inSight) {
+        if (enemy->canSeePlayer()) {
             isSpotted = true;
             enemy->setAIState(CHASING);
         }
-
-        if (isSpotted) {
-            mGameState.shaderStatus = 1; // Spotted
-        }
-        else {
-            mGameState.shaderStatus = 0; // Normal
-        }
+    }
+    mGameState.shaderStatus = isSpotted ? 1 : 0; // Spotted / Normal
+
+    //  COMBAT TRIGGERS 
+    // Only enemies near the player can be in ambush or contact range
+    mNearby.clear();
+    mEnemyGrid.queryRadius(player->getPosition(),
+        AMBUSH_DISTANCE + player->getColliderDimensions().x, mNearby);
+    for (Entity* enemy : mNearby)
+    {
+        int i = (int)(enemy - mGameState.worldEnemies);
+        if (!enemy->isActive()) continue;
 
         // Ambush Attempt (player advantage)
-        if (IsKeyPressed(KEY_SPACE)) {
+        if (gInput.isPressed(KEY_SPACE)) {
             float distToEnemy = Vector2Distance(player->getPosition(), enemy->getPosition());
             if (distToEnemy < AMBUSH_DISTANCE) {
                 if (player->checkAmbush(enemy)) {
@@ -398,26 +432,32 @@ void LevelOne::update(float deltaTime)
 void LevelOne::render()
 {
     // Draw Room
-    if (mGameState.map) mGameState.map->render();
+    if (mGameState.map) mGameState.map->render(&mGameState.camera);
+
+    // Sprites go through one batch: layers keep the old order (props,
+    // enemies, party) and sprites sharing an atlas are drawn together
+    mSpriteBatch.begin(&mGameState.camera);
 
     // Draw Props (chests)
     for (int i = 0; i < mPropCount; ++i) {
-        if (mWorldProps[i].isActive()) mWorldProps[i].render();
+        mWorldProps[i].render(&mSpriteBatch, LAYER_PROPS);
     }
 
     // Draw Enemies
     for (int i = 0; i < mGameState.enemyCount; i++)
     {
-        mGameState.worldEnemies[i].render();
+        mGameState.worldEnemies[i].render(&mSpriteBatch, LAYER_ENEMIES);
     }
 
     // Draw Followers
     for (Entity* f : mFollowers) {
-        if (f) f->render();
+        if (f) f->render(&mSpriteBatch, LAYER_PARTY);
     }
 
     // Draw Player
-    if (mGameState.player) mGameState.player->render();
+    if (mGameState.player) mGameState.player->render(&mSpriteBatch, LAYER_PARTY);
+
+    mSpriteBatch.flush();
 
     // Draw enemy view cones (simple sectors)
     for (int i = 0; i < mGameState.enemyCount; i++)
@@ -425,7 +465,7 @@ void LevelOne::render()
         Entity* e = &mGameState.worldEnemies[i];
         if (!e->isActive()) continue;
 
-        Vector2 pos = e->getPosition();
+        Vector2 pos = e->getRenderPosition();
         Vector2 dir = e->getDirectionVector();
         // Convert facing vector to angle in degrees (Raylib expects degrees)
         float angleDeg = atan2f(dir.y, dir.x) * (180.0f / PI);
@@ -441,10 +481,10 @@ void LevelOne::render()
 
 void LevelOne::shutdown()
 {
-    // Stop and unload exploration music when leaving the scene
+    // Stop exploration music and hand it back to the cache when leaving the scene
     if (mGameState.bgm.ctxData) {
         StopMusicStream(mGameState.bgm);
-        UnloadMusicStream(mGameState.bgm);
+        gAssetCache.releaseMusic(mGameState.bgm);
         // Reset the bgm handle to a null state
         mGameState.bgm.ctxData = nullptr;
     }
@@ -1,5 +1,7 @@
 #include "../lib/Scene.h"
 #include "../lib/Map.h"
+#include "../lib/SpatialHash.h"
+#include "../lib/AIScheduler.h"
 
 // Forward declare Effects to avoid circular dependency
 class Effects;
@@ -17,6 +19,7 @@ public:
     void update(float deltaTime) override;
     void render() override;
     void shutdown() override; 
+    const AssetManifest &getAssetManifest() const override;
 private:
     // Level-specific enemy defeat flags cached locally for convenience
     std::vector<bool> mEnemyDefeated;
@@ -26,6 +29,15 @@ private:
     Entity* mWorldProps = nullptr;
     int     mPropCount  = 0;
 
+    // Broadphase grids, two tiles per cell (sized in initialise())
+    SpatialHash mPropGrid;         // chests; static, built in initialise()
+    SpatialHash mFollowerGrid;     // rebuilt each frame for separation
+    SpatialHash mEnemyGrid;        // rebuilt each frame after enemies move
+    std::vector<Entity*> mNearby;  // scratch query results
+
+    SpriteBatch mSpriteBatch;      // world sprites, grouped by texture
+    AIScheduler mAIScheduler;      // spreads enemy perception across ticks
+
     //  TRANSITION EFFECTS 
     Effects* mEffects = nullptr;
     bool mIsTransitioning = false;
@@ -1,12 +1,23 @@
 #include "LevelThree.h"
 #include "../lib/Effects.h"
 #include "../lib/GameData.h"
+#include "../lib/Input.h"
+#include "../lib/Profiler.h"
 #include <raylib.h>
 extern float gMusicVolume;
 #include <cmath>
 
 extern int gCurrentLevelIndex;
 
+// Everything this scene loads, kept resident between visits
+static const AssetManifest LEVEL_THREE_ASSETS = {
+    { "assets/tileset.png", "assets/characters.png", "assets/enemy_atlas.png" },
+    { },
+    { "assets/audio/levelmusic.mp3" }
+};
+
+const AssetManifest &LevelThree::getAssetManifest() const { return LEVEL_THREE_ASSETS; }
+
 void LevelThree::initialise()
 {
     mGameState.nextSceneID = -1;
@@ -16,8 +27,7 @@ void LevelThree::initialise()
     mFollowers.clear();
     if (mWorldProps) { delete[] mWorldProps; mWorldProps = nullptr; mPropCount = 0; }
 
-    if (mGameState.map) { delete mGameState.map; mGameState.map = nullptr; }
-    mGameState.map = new Map(20, 20, mLevelData, "assets/tileset.png", 32.0f, 4, 1, mOrigin);
+    if (!mGameState.map) mGameState.map = new Map(20, 20, mLevelData, "assets/tileset.png", 32.0f, 4, 1, mOrigin);
     if (mGameState.map) {
         mGameState.map->revealTiles(mOrigin, 2000.0f);
     }
@@ -99,7 +109,6 @@ void LevelThree::initialise()
     {
         mGameState.enemyCount = 1;
         mGameState.worldEnemies = new Entity[mGameState.enemyCount];
-        mGameState.worldEnemies[0] = Entity();
         mGameState.worldEnemies[0].setPosition({ 630.0f, 270.0f });
         mGameState.worldEnemies[0].setTexture("assets/enemy_atlas.png");
         mGameState.worldEnemies[0].setTextureType(ATLAS);
@@ -140,9 +149,9 @@ void LevelThree::initialise()
     mIsTransitioning = false;
 
     // BGM
-    if (mGameState.bgm.ctxData) { StopMusicStream(mGameState.bgm); UnloadMusicStream(mGameState.bgm); }
+    if (mGameState.bgm.ctxData) { StopMusicStream(mGameState.bgm); gAssetCache.releaseMusic(mGameState.bgm); }
     if (FileExists("assets/audio/levelmusic.mp3")) {
-        mGameState.bgm = LoadMusicStream("assets/audio/levelmusic.mp3");
+        mGameState.bgm = gAssetCache.acquireMusic("assets/audio/levelmusic.mp3");
         SetMusicVolume(mGameState.bgm, gMusicVolume);
         PlayMusicStream(mGameState.bgm);
     }
@@ -150,7 +159,11 @@ void LevelThree::initialise()
 
 void LevelThree::update(float deltaTime)
 {
-    if (mGameState.bgm.ctxData) { SetMusicVolume(mGameState.bgm, gMusicVolume); UpdateMusicStream(mGameState.bgm); }
+    if (mGameState.bgm.ctxData) {
+        PROFILE_SCOPE(PROFILE_AUDIO);
+        SetMusicVolume(mGameState.bgm, gMusicVolume);
+        UpdateMusicStream(mGameState.bgm);
+    }
     // Player update & map interaction
     if (mGameState.player) {
         mGameState.player->update(deltaTime, mGameState.player, mGameState.map, mWorldProps, mPropCount);
@@ -165,10 +178,12 @@ void LevelThree::update(float deltaTime)
     constexpr float REPEL_STRENGTH  = 20000.0f;
     constexpr float JITTER_STRENGTH = 5.0f;
     constexpr float DAMPING         = 0.90f;
+    mFollowerGrid.clear();
+    for (Entity* f : mFollowers) mFollowerGrid.insert(f);
     for (Entity* f : mFollowers) {
         if (!f) continue;
-        f->updateFollowerPhysics(mGameState.player, mFollowers, mGameState.map, deltaTime,
-            TETHER_SPEED, REPEL_STRENGTH, JITTER_STRENGTH, DAMPING);
+        f->updateFollowerPhysics(mGameState.player, &mFollowerGrid, mGameState.map, deltaTime,
+            TETHER_SPEED, REPEL_STRENGTH, JITTER_STRENGTH, DAMPING, mGameState.rng.jitter);
     }
 
     const float AMBUSH_DISTANCE = 60.0f;
@@ -179,11 +194,14 @@ void LevelThree::update(float deltaTime)
         if (!mGameState.worldEnemies) break;
         Entity* enemy = &mGameState.worldEnemies[i];
         Entity* player = mGameState.player;
-        if (enemy) enemy->update(deltaTime, player, mGameState.map, NULL, 0);
+        if (enemy) {
+            PROFILE_SCOPE(PROFILE_AI);
+            enemy->update(deltaTime, player, mGameState.map, NULL, 0);
+        }
         if (!enemy || !enemy->isActive()) continue;
 
         // Ambush attempt
-        if (IsKeyPressed(KEY_SPACE) && player) {
+        if (gInput.isPressed(KEY_SPACE) && player) {
             float distToEnemy = Vector2Distance(player->getPosition(), enemy->getPosition());
             if (distToEnemy < AMBUSH_DISTANCE) {
                 if (player->checkAmbush(enemy)) {
@@ -212,17 +230,20 @@ void LevelThree::update(float deltaTime)
 
 void LevelThree::render()
 {
-    if (mGameState.map) mGameState.map->render();
+    if (mGameState.map) mGameState.map->render(&mGameState.camera);
 
+    mSpriteBatch.begin(&mGameState.camera);
 
     if (mGameState.worldEnemies) {
         for (int i = 0; i < mGameState.enemyCount; ++i) {
-            mGameState.worldEnemies[i].render();
+            mGameState.worldEnemies[i].render(&mSpriteBatch, LAYER_ENEMIES);
         }
     }
 
-    for (Entity* f : mFollowers) { if (f) f->render(); }
-    if (mGameState.player) mGameState.player->render();
+    for (Entity* f : mFollowers) { if (f) f->render(&mSpriteBatch, LAYER_PARTY); }
+    if (mGameState.player) mGameState.player->render(&mSpriteBatch, LAYER_PARTY);
+
+    mSpriteBatch.flush();
 
     if (mEffects) mEffects->render();
 }
@@ -234,4 +255,10 @@ void LevelThree::shutdown()
     if (mWorldProps) { delete[] mWorldProps; mWorldProps = nullptr; }
     if (mGameState.worldEnemies) { delete[] mGameState.worldEnemies; mGameState.worldEnemies = nullptr; }
     if (mEffects) { delete mEffects; mEffects = nullptr; }
+    // Stop exploration music and hand it back to the cache
+    if (mGameState.bgm.ctxData) {
+        StopMusicStream(mGameState.bgm);
+        gAssetCache.releaseMusic(mGameState.bgm);
+        mGameState.bgm.ctxData = nullptr;
+    }
 }
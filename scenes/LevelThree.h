@@ -3,6 +3,7 @@
 
 #include "../lib/Scene.h"
 #include "../lib/Map.h"
+#include "../lib/SpatialHash.h"
 
 class Effects;
 
@@ -15,10 +16,15 @@ public:
     void update(float deltaTime) override;
     void render() override;
     void shutdown() override;
+    const AssetManifest &getAssetManifest() const override;
 private:
     std::vector<Entity*> mFollowers;
     Entity* mWorldProps = nullptr;
     int     mPropCount  = 0;
+    // Follower separation grid, rebuilt each frame
+    SpatialHash mFollowerGrid;
+
+    SpriteBatch mSpriteBatch;      // world sprites, grouped by texture
 
     Effects* mEffects = nullptr;
     bool mIsTransitioning = false;
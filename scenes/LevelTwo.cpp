@@ -1,12 +1,24 @@
 #include "LevelTwo.h"
 #include "../lib/Effects.h"
 #include "../lib/GameData.h"
+#include "../lib/Input.h"
+#include "../lib/Profiler.h"
 #include <raylib.h>
 extern float gMusicVolume;
 #include <cmath>
 
 extern int gCurrentLevelIndex;
 
+// Everything this scene loads, kept resident between visits
+static const AssetManifest LEVEL_TWO_ASSETS = {
+    { "assets/tileset.png", "assets/characters.png", "assets/enemy_atlas.png", "assets/chest.png",
+      "assets/light_blue.png" },
+    { },
+    { "assets/audio/levelmusic.mp3" }
+};
+
+const AssetManifest &LevelTwo::getAssetManifest() const { return LEVEL_TWO_ASSETS; }
+
 void LevelTwo::initialise()
 {
     mGameState.nextSceneID = -1;
@@ -16,9 +28,8 @@ void LevelTwo::initialise()
     if (!mFollowers.empty()) { for (Entity* f : mFollowers) { delete f; } mFollowers.clear(); }
     if (mWorldProps) { delete[] mWorldProps; mWorldProps = nullptr; mPropCount = 0; }
 
-    // Load map
-    if (mGameState.map) { delete mGameState.map; mGameState.map = nullptr; }
-    mGameState.map = new Map(50, 50, mLevelData, "assets/tileset.png", 32.0f, 4, 1, mOrigin);
+    // Load map (built once; the layout is static so re-entry reuses it)
+    if (!mGameState.map) mGameState.map = new Map(50, 50, mLevelData, "assets/tileset.png", 32.0f, 4, 1, mOrigin);
 
     // Player setup
     if (mGameState.player) { delete mGameState.player; mGameState.player = nullptr; }
@@ -148,7 +159,6 @@ void LevelTwo::initialise()
 
             for (size_t i = 0; i < spawns.size(); ++i) {
                 const auto& s = spawns[i];
-                mGameState.worldEnemies[i] = Entity();
                 mGameState.worldEnemies[i].setPosition(s.pos);
                 // Default sprite for guards/sentries
                 mGameState.worldEnemies[i].setScale({ 64.0f, 50.0f });
@@ -228,7 +238,6 @@ void LevelTwo::initialise()
         for (size_t i = 0; i < chestPositions.size(); ++i) {
             if (mGameState.openedChests[i]) continue; // Skip spawning opened chests
 
-            mWorldProps[propIndex] = Entity();
             mWorldProps[propIndex].setEntityType(PROP);
             mWorldProps[propIndex].setIsChest(true);
             mWorldProps[propIndex].setPosition(chestPositions[i]);
@@ -242,15 +251,24 @@ void LevelTwo::initialise()
         }
     }
 
+    // Broadphase: chests never move, so their grid is built once per visit
+    float cellSize = mGameState.map ? mGameState.map->getTileSize() * 2.0f : 64.0f;
+    mPropGrid.setCellSize(cellSize);
+    mFollowerGrid.setCellSize(cellSize);
+    mEnemyGrid.setCellSize(cellSize);
+    mAIScheduler.reset(mGameState.enemyCount);
+    mPropGrid.clear();
+    for (int i = 0; i < mPropCount; ++i) mPropGrid.insert(&mWorldProps[i]);
+
     // Camera
     mGameState.camera.target = mGameState.player->getPosition();
     mGameState.camera.offset = mOrigin;
     mGameState.camera.rotation = 0.0f;
     mGameState.camera.zoom = 2.0f;
 
-    // Restore any saved exploration state for this map
-    if (mGameState.map && !mGameState.revealedTiles.empty()) {
-        mGameState.map->setExploredTiles(mGameState.revealedTiles);
+    // Exploration is written straight into the persisted buffer (restoring any saved state)
+    if (mGameState.map) {
+        mGameState.map->attachExploredTiles(&mGameState.revealedTiles);
     }
 
     // Effects
@@ -260,9 +278,9 @@ void LevelTwo::initialise()
     mIsTransitioning = false;
 
     // BGM
-    if (mGameState.bgm.ctxData) { StopMusicStream(mGameState.bgm); UnloadMusicStream(mGameState.bgm); }
+    if (mGameState.bgm.ctxData) { StopMusicStream(mGameState.bgm); gAssetCache.releaseMusic(mGameState.bgm); }
     if (FileExists("assets/audio/levelmusic.mp3")) {
-        mGameState.bgm = LoadMusicStream("assets/audio/levelmusic.mp3");
+        mGameState.bgm = gAssetCache.acquireMusic("assets/audio/levelmusic.mp3");
         SetMusicVolume(mGameState.bgm, gMusicVolume);
         PlayMusicStream(mGameState.bgm);
     }
@@ -270,7 +288,11 @@ void LevelTwo::initialise()
 
 void LevelTwo::update(float deltaTime)
 {
-    if (mGameState.bgm.ctxData) { SetMusicVolume(mGameState.bgm, gMusicVolume); UpdateMusicStream(mGameState.bgm); }
+    if (mGameState.bgm.ctxData) {
+        PROFILE_SCOPE(PROFILE_AUDIO);
+        SetMusicVolume(mGameState.bgm, gMusicVolume);
+        UpdateMusicStream(mGameState.bgm);
+    }
     if (mIsTransitioning)
     {
         Vector2 camTarget = mGameState.camera.target;
@@ -284,11 +306,10 @@ void LevelTwo::update(float deltaTime)
     }
 
     // Player update & map interaction
-    mGameState.player->update(deltaTime, mGameState.player, mGameState.map, mWorldProps, mPropCount);
+    mGameState.player->update(deltaTime, mGameState.player, mGameState.map, &mPropGrid);
     if (mGameState.map && mGameState.player) {
         Vector2 pPos = mGameState.player->getPosition();
         mGameState.map->revealTiles(pPos, 200.0f);
-        mGameState.revealedTiles = mGameState.map->getExploredTiles();
     }
 
     // Followers physics
@@ -296,28 +317,30 @@ void LevelTwo::update(float deltaTime)
     constexpr float REPEL_STRENGTH  = 20000.0f;
     constexpr float JITTER_STRENGTH = 5.0f;
     constexpr float DAMPING         = 0.90f;
+    mFollowerGrid.clear();
+    for (Entity* f : mFollowers) mFollowerGrid.insert(f);
     for (Entity* f : mFollowers) {
         if (!f) continue;
-        f->updateFollowerPhysics(mGameState.player, mFollowers, mGameState.map, deltaTime,
-            TETHER_SPEED, REPEL_STRENGTH, JITTER_STRENGTH, DAMPING);
+        f->updateFollowerPhysics(mGameState.player, &mFollowerGrid, mGameState.map, deltaTime,
+            TETHER_SPEED, REPEL_STRENGTH, JITTER_STRENGTH, DAMPING, mGameState.rng.jitter);
     }
 
     // STEALTH / DETECTION CONSTANTS
     const float AMBUSH_DISTANCE = 60.0f;
-    const float SIGHT_DISTANCE  = 100.0f;
-    const float SIGHT_ANGLE     = 90.0f;
     bool isSpotted = false;
 
     // Chest interaction
-    if (IsKeyPressed(KEY_SPACE)) {
+    if (gInput.isPressed(KEY_SPACE)) {
         Entity* player = mGameState.player;
-        for (int i = 0; i < mPropCount; ++i) {
-            Entity* prop = &mWorldProps[i];
+        mNearby.clear();
+        mPropGrid.queryRadius(player->getPosition(), 50.0f, mNearby);
+        for (Entity* prop : mNearby) {
+            int i = (int)(prop - mWorldProps);
             if (!prop->isActive() || !prop->isChest()) continue;
             float dist = Vector2Distance(player->getPosition(), prop->getPosition());
             if (dist < 50.0f) {
                 if (player->isEntityInSight(prop, 60.0f, 60.0f)) {
-                    Item loot = getRandomChestItem(1);
+                    Item loot = getRandomChestItem(1, mGameState.rng.loot);
                     mGameState.inventory.push_back(loot);
                     mGameState.itemToast = std::string("Obtained: ") + loot.name;
                     mGameState.itemToastTimer = 2.0f;
@@ -341,34 +364,50 @@ void LevelTwo::update(float deltaTime)
         mGameState.nextSceneID = 4; 
     }
 
-    // Enemies update & combat triggers
+    // Enemies update
+    Entity* player = mGameState.player;
+    // Perception first (rate-limited per enemy), so the AI and the detection
+    // pass below read the same answer
+    {
+        PROFILE_SCOPE(PROFILE_AI);
+        mAIScheduler.update(mGameState.worldEnemies, mGameState.enemyCount, player, mGameState.map, deltaTime);
+        for (int i = 0; i < mGameState.enemyCount; i++)
+        {
+            mGameState.worldEnemies[i].update(deltaTime, player, mGameState.map, NULL, 0);
+        }
+    }
+    mEnemyGrid.clear();
     for (int i = 0; i < mGameState.enemyCount; i++)
     {
-        Entity* enemy  = &mGameState.worldEnemies[i];
-        Entity* player = mGameState.player;
+        if (mGameState.worldEnemies[i].isActive()) mEnemyGrid.insert(&mGameState.worldEnemies[i]);
+    }
 
-        enemy->update(deltaTime, player, mGameState.map, NULL, 0);
-        if (!enemy->isActive()) continue;
+    // Detection: only guards have vision cones; sentries/searchlights do not.
+    // The scheduler already ran each guard's cone + line-of-sight test.
+    for (int i = 0; i < mGameState.enemyCount; i++)
+    {
+        Entity* enemy = &mGameState.worldEnemies[i];
+        if (!enemy->isActive() || enemy->getAIType() != AI_GUARD) continue;
 
-        // Only guards have vision cones; sentries/searchlights do not.
-        bool inSight = false;
-        if (enemy->getAIType() == AI_GUARD) {
-            inSight = enemy->isEntityInSight(player, SIGHT_DISTANCE, SIGHT_ANGLE);
-            if (inSight && mGameState.map) {
-                 if (!mGameState.map->hasLineOfSight(enemy->getPosition(), player->getPosition())) {
-                     inSight = false;
-                 }
-            }
-            if (inSight) {
-                isSpotted = true;
-                enemy->setAIState(CHASING);
-            }
+        if (enemy->canSeePlayer()) {
+            isSpotted = true;
+            enemy->setAIState(CHASING);
         }
-
-        mGameState.shaderStatus = isSpotted ? 1 : 0;
+    }
+    mGameState.shaderStatus = isSpotted ? 1 : 0;
+
+    // Combat triggers
+    // Only enemies near the player can be in ambush or contact range
+    mNearby.clear();
+    mEnemyGrid.queryRadius(player->getPosition(),
+        AMBUSH_DISTANCE + player->getColliderDimensions().x, mNearby);
+    for (Entity* enemy : mNearby)
+    {
+        int i = (int)(enemy - mGameState.worldEnemies);
+        if (!enemy->isActive()) continue;
 
         // Ambush attempt (SPACE) should not work on searchlights
-        if (IsKeyPressed(KEY_SPACE)) {
+        if (gInput.isPressed(KEY_SPACE)) {
             if (enemy->getAIType() != AI_SEARCHLIGHT) {
                 float distToEnemy = Vector2Distance(player->getPosition(), enemy->getPosition());
                 if (distToEnemy < AMBUSH_DISTANCE) {
@@ -421,33 +460,41 @@ void LevelTwo::update(float deltaTime)
 
 void LevelTwo::render()
 {
-    if (mGameState.map) mGameState.map->render();
+    if (mGameState.map) mGameState.map->render(&mGameState.camera);
+
+    // Props and enemies are batched; the batch is flushed before the cones
+    // so they still draw over enemies and under the party
+    mSpriteBatch.begin(&mGameState.camera);
 
     // Props
     for (int i = 0; i < mPropCount; ++i) {
-        if (mWorldProps[i].isActive()) mWorldProps[i].render();
+        mWorldProps[i].render(&mSpriteBatch, LAYER_PROPS);
     }
 
     // Enemies
     for (int i = 0; i < mGameState.enemyCount; i++)
     {
-        mGameState.worldEnemies[i].render();
+        mGameState.worldEnemies[i].render(&mSpriteBatch, LAYER_ENEMIES);
     }
 
+    mSpriteBatch.flush();
+
     // Debug cones: only draw for guards
     for (int i = 0; i < mGameState.enemyCount; i++)
     {
         Entity* e = &mGameState.worldEnemies[i];
         if (!e->isActive()) continue;
         if (e->getAIType() != AI_GUARD) continue;
-        Vector2 pos = e->getPosition();
+        Vector2 pos = e->getRenderPosition();
         Vector2 dir = e->getDirectionVector();
         float angleDeg = atan2f(dir.y, dir.x) * (180.0f / PI);
         DrawCircleSector(pos, 100.0f, angleDeg - 45.0f, angleDeg + 45.0f, 10, Fade(RED, 0.2f));
     }
 
-    for (Entity* f : mFollowers) { if (f) f->render(); }
-    if (mGameState.player) mGameState.player->render();
+    mSpriteBatch.begin(&mGameState.camera);
+    for (Entity* f : mFollowers) { if (f) f->render(&mSpriteBatch, LAYER_PARTY); }
+    if (mGameState.player) mGameState.player->render(&mSpriteBatch, LAYER_PARTY);
+    mSpriteBatch.flush();
 
     if (mEffects) mEffects->render();
 }
@@ -460,4 +507,10 @@ void LevelTwo::shutdown()
     if (mWorldProps) { delete[] mWorldProps; mWorldProps = nullptr; }
     if (mGameState.worldEnemies) { delete[] mGameState.worldEnemies; mGameState.worldEnemies = nullptr; }
     if (mEffects) { delete mEffects; mEffects = nullptr; }
+    // Stop exploration music and hand it back to the cache
+    if (mGameState.bgm.ctxData) {
+        StopMusicStream(mGameState.bgm);
+        gAssetCache.releaseMusic(mGameState.bgm);
+        mGameState.bgm.ctxData = nullptr;
+    }
 }
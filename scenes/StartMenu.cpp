@@ -1,4 +1,5 @@
 #include "StartMenu.h"
+#include "../lib/Input.h"
 #include "raylib.h"
 #include <string>
 
@@ -24,7 +25,7 @@ void StartMenu::update(float deltaTime)
     }
 
     if (mPhase == PRESS_START) {
-        if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
+        if (gInput.isPressed(KEY_ENTER) || gInput.isPressed(KEY_SPACE)) {
             mPhase = LEVEL_SELECT;
             gGameStatus = TITLE; // keep input handling out of exploration branch
         }
@@ -32,13 +33,13 @@ void StartMenu::update(float deltaTime)
     }
 
     // Level selection
-    if (IsKeyPressed(KEY_UP)) {
+    if (gInput.isPressed(KEY_UP)) {
         mSelection = (mSelection - 1 + (int)mOptions.size()) % (int)mOptions.size();
-    } else if (IsKeyPressed(KEY_DOWN)) {
+    } else if (gInput.isPressed(KEY_DOWN)) {
         mSelection = (mSelection + 1) % (int)mOptions.size();
     }
 
-    if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
+    if (gInput.isPressed(KEY_ENTER) || gInput.isPressed(KEY_SPACE)) {
         // Map selection to scene indices: 0 = Level One, 1 = Level Two, 4 = Level Three
         if (mSelection == 0) mGameState.nextSceneID = 0;
         else if (mSelection == 1) mGameState.nextSceneID = 1;
@@ -4,6 +4,11 @@ uniform sampler2D texture0;
 uniform vec2 lightPosition;
 uniform int status; 
 
+// Fog of war: one texel per map tile (1 = explored), stretched over the
+// map's world-space bounds (x, y, width, height). Zero width disables fog.
+uniform sampler2D fogMask;
+uniform vec4 fogBounds;
+
 // Input from Vertex Shader
 in vec2 fragTexCoord;
 in vec2 fragPosition;
@@ -16,6 +21,9 @@ const float LINEAR_TERM    = 0.00003;
 const float QUADRATIC_TERM = 0.00003;
 const float MIN_BRIGHTNESS = 0.05;
 
+// Unexplored tiles keep 25% of their colour (a 75% black overlay)
+const float FOG_BRIGHTNESS = 0.25;
+
 float attenuate(float distance, float linearTerm, float quadraticTerm)
 {
     float attenuation = 1.0 / (1.0 + linearTerm * distance + quadraticTerm * distance * distance);
@@ -32,6 +40,14 @@ void main()
     // This restores the Red/Transparent tints
     vec4 texColor = texture(texture0, fragTexCoord) * fragColor; 
     
+    // Apply Fog of War
+    if (fogBounds.z > 0.0)
+    {
+        vec2 fogCoord = (fragPosition - fogBounds.xy) / fogBounds.zw;
+        float explored = texture(fogMask, fogCoord).r;
+        brightness *= mix(FOG_BRIGHTNESS, 1.0, explored);
+    }
+
     // Apply Lighting (Keep alpha intact)
     vec4 litColor = vec4(texColor.rgb * brightness, texColor.a);
 
@@ -0,0 +1,368 @@
+/**
+* Combat simulator: plays seeded battles with the game's combat rules
+* (lib/CombatRules) on every core, with no window, scene or timers, and
+* reports outcomes per encounter pool. Build with `make combat_sim`.
+*
+*   ./combat_sim [--battles 100000] [--level L]... [--threads T] [--seed S]
+*                [--policy greedy|attack] [--surprise] [--cunning C]
+*
+* --level picks the pool (0 = Level 1, 1 = Level 2, 4 = boss; repeatable,
+*   default all three). Level 2 and later use the boosted party.
+* --policy greedy plays like a careful player: heals, revives, guards when
+*   a hit would floor it, hits weaknesses, empties the gun. attack only ever melees the first enemy,
+*   like the headless driver's default input.
+* --surprise starts every battle on the enemy turn (caught while chasing).
+* --cunning sets how often enemies play the lookahead move (0..1) instead
+*   of the level's own setting (lib/CombatAI).
+*
+* Battle n always uses streams seeded from (seed, n), so results do not
+* depend on the thread count, and every pool faces the same dice.
+**/
+
+#include "../lib/CombatRules.h"
+#include "../lib/CombatAI.h"
+#include "../lib/GameData.h"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+constexpr int MAX_ACTIONS   = 2000; // a battle this long counts as a timeout
+constexpr int ROUND_BUCKETS = 64;   // rounds histogram; the last bucket is "or more"
+constexpr int HP_BUCKETS    = 101;  // whole percent of party HP lost
+
+enum Policy { POLICY_GREEDY, POLICY_ATTACK };
+
+struct BattleOutcome
+{
+    bool won      = false;
+    bool timedOut = false;
+    int  rounds   = 0;   // player phases started
+    int  hpLostPercent = 0;
+    int  allyDeaths    = 0;
+};
+
+// Per pool; merged across threads
+struct PoolStats
+{
+    long long battles = 0, wins = 0, losses = 0, timeouts = 0;
+    long long allyDeaths = 0;
+    long long rounds[ROUND_BUCKETS]  = {};
+    long long hpLost[HP_BUCKETS]     = {}; // won battles only
+    std::map<std::string, std::pair<long long, long long>> byEnemy; // name -> (battles, wins)
+
+    void add(const PoolStats &other)
+    {
+        battles += other.battles; wins += other.wins; losses += other.losses; timeouts += other.timeouts;
+        allyDeaths += other.allyDeaths;
+        for (int i = 0; i < ROUND_BUCKETS; i++) rounds[i] += other.rounds[i];
+        for (int i = 0; i < HP_BUCKETS; i++)    hpLost[i] += other.hpLost[i];
+        for (const auto &entry : other.byEnemy)
+        {
+            byEnemy[entry.first].first  += entry.second.first;
+            byEnemy[entry.first].second += entry.second.second;
+        }
+    }
+};
+
+static int firstAlive(const std::vector<Combatant> &combatants)
+{
+    for (int i = 0; i < (int) combatants.size(); i++)
+        if (combatants[i].isAlive) return i;
+    return -1;
+}
+
+// What a turn does: mirrors the command wheel
+static CombatAction chooseAction(Policy policy, int actorIndex, const std::vector<Combatant> &party,
+                                 const std::vector<Combatant> &enemies, const std::vector<Item> &inventory)
+{
+    CombatAction action(ACTION_MELEE);
+    action.actor  = partyHandle(actorIndex);
+    action.target = enemyHandle(firstAlive(enemies));
+    if (policy == POLICY_ATTACK) return action;
+
+    const Combatant &actor = party[actorIndex];
+
+    // Revive a fallen ally, then patch up anyone under 40%
+    for (int i = 0; i < (int) party.size(); i++)
+    {
+        if (party[i].isAlive) continue;
+        for (int n = 0; n < (int) inventory.size(); n++)
+            if (inventory[n].isRevive) { action.type = ACTION_ITEM; action.item = &inventory[n]; action.target = partyHandle(i); return action; }
+    }
+    int hurt = -1;
+    for (int i = 0; i < (int) party.size(); i++)
+    {
+        const Combatant &m = party[i];
+        if (m.isAlive && m.currentHp * 10 < m.maxHp * 4 && (hurt < 0 || m.currentHp * party[hurt].maxHp < party[hurt].currentHp * m.maxHp))
+            hurt = i;
+    }
+    if (hurt >= 0)
+    {
+        for (int s = 0; s < (int) actor.skills.size(); s++)
+            if (actor.skills[s].damage < 0 && canAfford(actor, actor.skills[s])) { action.type = ACTION_SKILL; action.skill = s; action.target = partyHandle(hurt); return action; }
+        for (int n = 0; n < (int) inventory.size(); n++)
+            if (!inventory[n].isSP && !inventory[n].isRevive) { action.type = ACTION_ITEM; action.item = &inventory[n]; action.target = partyHandle(hurt); return action; }
+    }
+
+    // Nothing to heal with: guard (halving enemy hits) if the hardest hit
+    // would floor the actor and half of it would not
+    bool canHeal = false;
+    for (const Ability &skill : actor.skills)
+        if (skill.damage < 0 && canAfford(actor, skill)) canHeal = true;
+    for (const Item &item : inventory)
+        if (!item.isSP && !item.isRevive) canHeal = true;
+    int hardestHit = 0;
+    for (const Combatant &enemy : enemies)
+        if (enemy.isAlive) hardestHit = std::max(hardestHit, enemy.baseAttack);
+    if (!canHeal && actor.currentHp <= hardestHit && actor.currentHp > hardestHit / 2)
+    {
+        action.type = ACTION_GUARD;
+        return action;
+    }
+
+    // Knock down a standing enemy through a weakness, cheapest way first
+    for (int e = 0; e < (int) enemies.size(); e++)
+    {
+        const Combatant &enemy = enemies[e];
+        if (!enemy.isAlive || enemy.isDown) continue;
+
+        if (actor.currentAmmo > 0 && isWeakTo(enemy, GUN)) { action.type = ACTION_GUN; action.target = enemyHandle(e); return action; }
+        if (isWeakTo(enemy, PHYS)) { action.type = ACTION_MELEE; action.target = enemyHandle(e); return action; }
+
+        int best = -1;
+        for (int s = 0; s < (int) actor.skills.size(); s++)
+        {
+            const Ability &skill = actor.skills[s];
+            if (skill.damage <= 0 || !canAfford(actor, skill) || !isWeakTo(enemy, skill.element)) continue;
+            if (best < 0 || skill.cost < actor.skills[best].cost) best = s;
+        }
+        if (best >= 0) { action.type = ACTION_SKILL; action.skill = best; action.target = enemyHandle(e); return action; }
+    }
+
+    // Otherwise focus the weakest enemy; shots keep the turn, so spend them first
+    int weakest = -1;
+    for (int e = 0; e < (int) enemies.size(); e++)
+        if (enemies[e].isAlive && (weakest < 0 || enemies[e].currentHp < enemies[weakest].currentHp)) weakest = e;
+    action.target = enemyHandle(weakest);
+    if (actor.currentAmmo > 0) action.type = ACTION_GUN;
+    return action;
+}
+
+// One battle, in the scene's turn order without the menus and waits. The
+// player always takes the all-out attack.
+static BattleOutcome runBattle(std::vector<Combatant> party, std::vector<Combatant> enemies,
+                               std::vector<Item> inventory, bool advantage, Policy policy, CombatAI &ai,
+                               RandomStream &rng)
+{
+    BattleOutcome outcome;
+    CombatEvents  events;
+    prepareParty(party);
+    ai.beginBattle(party, enemies);
+
+    int startHp = 0, maxHp = 0;
+    for (const Combatant &m : party) { startHp += m.currentHp; maxHp += m.maxHp; }
+
+    CombatTurn turn = firstTurn(party, enemies, advantage);
+    if (turn.phase != PHASE_ENEMY) outcome.rounds = 1;
+
+    for (int actions = 0; turn.phase != PHASE_OVER; actions++)
+    {
+        if (actions >= MAX_ACTIONS) { outcome.timedOut = true; break; }
+
+        CombatAction action(ACTION_ALL_OUT);
+        action.actor = partyHandle(turn.slot);
+        if (turn.phase == PHASE_ENEMY)      action = ai.chooseAction(party, enemies, turn.slot, rng);
+        else if (turn.phase == PHASE_PARTY) action = chooseAction(policy, turn.slot, party, enemies, inventory);
+
+        resolveAction(party, enemies, action, events);
+        applyEvents(party, enemies, events);
+        if (action.type == ACTION_ITEM) inventory.erase(inventory.begin() + (action.item - inventory.data()));
+
+        CombatTurn next = advanceTurn(party, enemies, turn, events);
+        if (turn.phase == PHASE_ENEMY && next.phase == PHASE_PARTY) outcome.rounds++;
+        turn = next;
+    }
+    outcome.won = !outcome.timedOut && !anyAlive(enemies);
+
+    int endHp = 0;
+    for (const Combatant &m : party)
+    {
+        endHp += m.currentHp;
+        if (!m.isAlive) outcome.allyDeaths++;
+    }
+    int lost = startHp - endHp;
+    outcome.hpLostPercent = (maxHp > 0 && lost > 0) ? std::min(100, lost * 100 / maxHp) : 0;
+    return outcome;
+}
+
+const int NO_SAMPLES = -1;
+
+// Smallest bucket holding the given fraction of the samples, or NO_SAMPLES
+static int percentile(const long long *histogram, int buckets, double fraction)
+{
+    long long total = 0;
+    for (int i = 0; i < buckets; i++) total += histogram[i];
+    if (total == 0) return NO_SAMPLES;
+    long long rank = (long long)(fraction * total);
+    long long seen = 0;
+    for (int i = 0; i < buckets; i++)
+    {
+        seen += histogram[i];
+        if (seen > rank) return i;
+    }
+    return buckets - 1;
+}
+
+static double mean(const long long *histogram, int buckets)
+{
+    long long total = 0, sum = 0;
+    for (int i = 0; i < buckets; i++) { total += histogram[i]; sum += histogram[i] * i; }
+    return total > 0 ? (double) sum / total : 0.0;
+}
+
+static void printPool(int level, const PoolStats &stats, double seconds, int threads)
+{
+    const char *name = level == 0 ? "Level 1" : level == 1 ? "Level 2" : level == 4 ? "boss" : "other";
+    double battles = stats.battles > 0 ? (double) stats.battles : 1.0;
+
+    printf("pool %s (level %d): %lld battles, %d threads, %.2f s (%.0f battles/s)\n",
+        name, level, stats.battles, threads, seconds, seconds > 0.0 ? stats.battles / seconds : 0.0);
+    printf("  win %.1f%%  loss %.1f%%  timeout %.1f%%  allies down per battle %.2f\n",
+        100.0 * stats.wins / battles, 100.0 * stats.losses / battles, 100.0 * stats.timeouts / battles,
+        stats.allyDeaths / battles);
+    if (stats.battles == 0) return;
+
+    printf("  rounds   mean %.2f  p50 %d  p90 %d  p99 %d\n", mean(stats.rounds, ROUND_BUCKETS),
+        percentile(stats.rounds, ROUND_BUCKETS, 0.5), percentile(stats.rounds, ROUND_BUCKETS, 0.9),
+        percentile(stats.rounds, ROUND_BUCKETS, 0.99));
+    if (stats.wins > 0)
+        printf("  HP lost  mean %.1f%%  p50 %d%%  p90 %d%%  p99 %d%%  (won battles)\n", mean(stats.hpLost, HP_BUCKETS),
+            percentile(stats.hpLost, HP_BUCKETS, 0.5), percentile(stats.hpLost, HP_BUCKETS, 0.9),
+            percentile(stats.hpLost, HP_BUCKETS, 0.99));
+    else
+        printf("  HP lost  n/a (no won battles)\n");
+
+    // Win rate of every battle the enemy appeared in
+    for (const auto &entry : stats.byEnemy)
+    {
+        long long seen = entry.second.first, won = entry.second.second;
+        printf("    %-12s in %5.1f%% of battles, win %.1f%%\n", entry.first.c_str(),
+            100.0 * seen / battles, seen > 0 ? 100.0 * won / seen : 0.0);
+    }
+}
+
+static PoolStats runPool(int level, long long battles, int threads, uint64_t seed, Policy policy, bool advantage,
+                         float cunning)
+{
+    const std::vector<Combatant> party     = makeStartingParty(level);
+    const std::vector<Item>      inventory = INITIAL_INVENTORY();
+    const long long CHUNK = 1024;
+
+    std::atomic<long long> next(0);
+    std::mutex mergeMutex;
+    PoolStats total;
+
+    // Workers claim battles in chunks and merge their tallies once at the end
+    auto worker = [&]()
+    {
+        PoolStats local;
+        RandomStreams rng;
+        CombatAI ai;
+        ai.setCunning(cunning >= 0.0f ? cunning : getEnemyCunning(level));
+        for (;;)
+        {
+            long long begin = next.fetch_add(CHUNK);
+            if (begin >= battles) break;
+            long long end = std::min(begin + CHUNK, battles);
+
+            for (long long n = begin; n < end; n++)
+            {
+                rng.seed(seed, (uint64_t) n);
+                std::vector<Combatant> enemies = rollEncounter(level, rng.encounters);
+                BattleOutcome outcome = runBattle(party, enemies, inventory, advantage, policy, ai, rng.combat);
+
+                local.battles++;
+                if (outcome.timedOut)  local.timeouts++;
+                else if (outcome.won)  local.wins++;
+                else                   local.losses++;
+                local.allyDeaths += outcome.allyDeaths;
+                local.rounds[std::min(outcome.rounds, ROUND_BUCKETS - 1)]++;
+                if (outcome.won) local.hpLost[outcome.hpLostPercent]++;
+
+                // Count each enemy type once per battle
+                for (int i = 0; i < (int) enemies.size(); i++)
+                {
+                    bool repeat = false;
+                    for (int j = 0; j < i; j++) if (enemies[j].name == enemies[i].name) repeat = true;
+                    if (repeat) continue;
+                    auto &tally = local.byEnemy[enemies[i].name];
+                    tally.first++;
+                    if (outcome.won) tally.second++;
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        total.add(local);
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) pool.push_back(std::thread(worker));
+    for (std::thread &thread : pool) thread.join();
+    return total;
+}
+
+int main(int argc, char **argv)
+{
+    long long battles = 100000;
+    int threads       = (int) std::thread::hardware_concurrency();
+    uint64_t seed     = 1;
+    Policy policy     = POLICY_GREEDY;
+    bool advantage    = true;
+    float cunning     = -1.0f; // per level
+    std::vector<int> levels;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if      (arg == "--battles" && hasValue) battles = atoll(argv[++i]);
+        else if (arg == "--threads" && hasValue) threads = atoi(argv[++i]);
+        else if (arg == "--seed"    && hasValue) seed    = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--level"   && hasValue) levels.push_back(atoi(argv[++i]));
+        else if (arg == "--policy"  && hasValue)
+        {
+            std::string name = argv[++i];
+            if      (name == "greedy") policy = POLICY_GREEDY;
+            else if (name == "attack") policy = POLICY_ATTACK;
+            else { printf("combat_sim: unknown policy '%s'\n", name.c_str()); return 1; }
+        }
+        else if (arg == "--cunning" && hasValue) cunning = (float) atof(argv[++i]);
+        else if (arg == "--surprise") advantage = false;
+        else {
+            printf("usage: %s [--battles N] [--level L]... [--threads T] [--seed S] [--policy greedy|attack] [--surprise]"
+                " [--cunning C]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (levels.empty()) levels = { 0, 1, 4 };
+    // Loaded before the workers start; they only read it
+    if (!gContentDB.load(CONTENT_BLOB_PATH)) return 1;
+
+    printf("seed %llu  policy %s  %s\n", (unsigned long long) seed,
+        policy == POLICY_GREEDY ? "greedy" : "attack", advantage ? "party first" : "enemies first");
+
+    int timeouts = 0;
+    for (int level : levels)
+    {
+        auto start = std::chrono::steady_clock::now();
+        PoolStats stats = runPool(level, battles, threads, seed, policy, advantage, cunning);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printPool(level, stats, seconds, threads);
+        timeouts += (int) std::min<long long>(stats.timeouts, 1);
+    }
+    return timeouts == 0 ? 0 : 1;
+}
@@ -0,0 +1,431 @@
+/**
+* Content compiler: turns the text definitions in assets/data/content.txt
+* into the binary blob ContentDB loads at startup (layout in
+* lib/ContentFormat.h). Build and run it with `make content`.
+*
+*   ./content_compiler [input.txt] [output.bin]
+*
+* Records may refer to ones defined later in the file. Any error is
+* reported with its line number, as is anything the game needs but the
+* file lacks, and no output is written.
+**/
+
+#include "../lib/ContentFormat.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// Mirrors Element and EquipmentType in lib/GameTypes.h
+static const char *ELEMENT_NAMES[] = { "NONE", "PHYS", "GUN", "FIRE", "ICE", "ELEC", "WIND", "PSI", "NUKE", "BLESS", "CURSE" };
+static const char *EQUIPMENT_TYPE_NAMES[] = { "melee", "gun", "armor" };
+static const char *POOL_KIND_NAMES[] = { "encounter", "chest_item", "chest_equipment", "start_inventory", "start_equipment" };
+
+struct Line
+{
+    int number;
+    std::vector<std::string> head;   // kind, key...
+    std::vector<std::string> fields; // after the first '|'
+};
+
+static const char *sInputPath = "";
+static bool sFailed = false;
+
+static void error(const Line &line, const char *message, const std::string &detail = "")
+{
+    printf("%s:%d: %s%s%s\n", sInputPath, line.number, message, detail.empty() ? "" : " ", detail.c_str());
+    sFailed = true;
+}
+
+static std::string trim(const std::string &text)
+{
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+static std::vector<std::string> splitWords(const std::string &text)
+{
+    std::vector<std::string> words;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t begin = text.find_first_not_of(" \t\r", pos);
+        if (begin == std::string::npos) break;
+        size_t end = text.find_first_of(" \t\r", begin);
+        if (end == std::string::npos) end = text.size();
+        words.push_back(text.substr(begin, end - begin));
+        pos = end;
+    }
+    return words;
+}
+
+static int findName(const char *const *names, int count, const std::string &name)
+{
+    for (int i = 0; i < count; i++)
+        if (name == names[i]) return i;
+    return -1;
+}
+
+class Compiler
+{
+private:
+    std::map<std::string, int> mSkillKeys, mItemKeys, mEquipmentKeys, mPersonaKeys, mMemberKeys;
+    std::map<int, int> mEnemyIds;
+
+    std::vector<SkillRecord>     mSkills;
+    std::vector<ItemRecord>      mItems;
+    std::vector<EquipmentRecord> mEquipment;
+    std::vector<PersonaRecord>   mPersonas;
+    std::vector<MemberRecord>    mMembers;
+    std::vector<EnemyRecord>     mEnemies;
+    std::vector<PoolRecord>      mPools;
+    std::vector<uint32_t>        mValues;
+
+    std::string mStrings = std::string(1, '\0'); // offset 0 is ""
+    std::map<std::string, ContentString> mInterned;
+
+public:
+    ContentString intern(const std::string &text)
+    {
+        if (text.empty()) return 0;
+        auto found = mInterned.find(text);
+        if (found != mInterned.end()) return found->second;
+
+        ContentString offset = (ContentString) mStrings.size();
+        mStrings += text;
+        mStrings += '\0';
+        mInterned[text] = offset;
+        return offset;
+    }
+
+    int toInt(const Line &line, const std::string &text)
+    {
+        char *end = nullptr;
+        long value = strtol(text.c_str(), &end, 10);
+        if (text.empty() || *end != '\0') error(line, "expected a number, got", "'" + text + "'");
+        return (int) value;
+    }
+
+    uint8_t toElement(const Line &line, const std::string &text)
+    {
+        int element = findName(ELEMENT_NAMES, (int)(sizeof(ELEMENT_NAMES) / sizeof(ELEMENT_NAMES[0])), text);
+        if (element < 0) error(line, "unknown element", text);
+        return (uint8_t)(element < 0 ? 0 : element);
+    }
+
+    int toEquipment(const Line &line, const std::string &key)
+    {
+        if (key == "-") return -1;
+        auto found = mEquipmentKeys.find(key);
+        if (found == mEquipmentKeys.end()) { error(line, "unknown equipment", key); return -1; }
+        return found->second;
+    }
+
+    // A list of keys from one table (or of numbers/elements) as a run of values
+    ContentList toList(const Line &line, const std::string &text, const std::map<std::string, int> *keys,
+                       bool elements = false, bool enemyIds = false)
+    {
+        ContentList list = { (uint32_t) mValues.size(), 0 };
+        if (text == "-") return list;
+
+        for (const std::string &word : splitWords(text))
+        {
+            uint32_t value = 0;
+            if (elements) value = toElement(line, word);
+            else if (enemyIds)
+            {
+                int id = toInt(line, word);
+                if (!mEnemyIds.count(id)) error(line, "unknown enemy id", word);
+                value = (uint32_t) id;
+            }
+            else
+            {
+                auto found = keys->find(word);
+                if (found == keys->end()) error(line, "unknown key", word);
+                else value = (uint32_t) found->second;
+            }
+            mValues.push_back(value);
+            list.count++;
+        }
+        return list;
+    }
+
+    bool expect(const Line &line, int headWords, int fieldCount)
+    {
+        if ((int) line.head.size() == headWords && (int) line.fields.size() == fieldCount) return true;
+        error(line, "wrong number of fields for", line.head[0]);
+        return false;
+    }
+
+    // Keys first, so records can refer to ones defined later
+    void declare(const Line &line)
+    {
+        const std::string &kind = line.head[0];
+        std::map<std::string, int> *keys = nullptr;
+        int index = 0;
+        if      (kind == "skill")     { keys = &mSkillKeys;     index = (int) mSkillKeys.size();     }
+        else if (kind == "item")      { keys = &mItemKeys;      index = (int) mItemKeys.size();      }
+        else if (kind == "equipment") { keys = &mEquipmentKeys; index = (int) mEquipmentKeys.size(); }
+        else if (kind == "persona")   { keys = &mPersonaKeys;   index = (int) mPersonaKeys.size();   }
+        else if (kind == "member")    { keys = &mMemberKeys;    index = (int) mMemberKeys.size();    }
+        else if (kind == "enemy")
+        {
+            if (line.head.size() < 2) return;
+            int id = toInt(line, line.head[1]);
+            if (mEnemyIds.count(id)) error(line, "duplicate enemy id", line.head[1]);
+            int enemyIndex = (int) mEnemyIds.size();
+            mEnemyIds[id] = enemyIndex;
+            return;
+        }
+        else if (kind == "pool") return;
+        else { error(line, "unknown record kind", kind); return; }
+
+        if (line.head.size() < 2) { error(line, "missing key"); return; }
+        if (keys->count(line.head[1])) error(line, "duplicate key", line.head[1]);
+        (*keys)[line.head[1]] = index;
+    }
+
+    void define(const Line &line)
+    {
+        const std::string &kind = line.head[0];
+        const std::vector<std::string> &f = line.fields;
+
+        if (kind == "skill")
+        {
+            if (!expect(line, 2, 5)) return;
+            SkillRecord skill = {};
+            skill.name    = intern(f[0]);
+            skill.cost    = toInt(line, f[1]);
+            skill.damage  = toInt(line, f[2]);
+            skill.element = toElement(line, f[3]);
+            if (f[4] != "magic" && f[4] != "physical") error(line, "expected magic or physical, got", f[4]);
+            skill.isMagic = f[4] == "magic";
+            mSkills.push_back(skill);
+        }
+        else if (kind == "item")
+        {
+            if (!expect(line, 2, 5)) return;
+            ItemRecord item = {};
+            item.name        = intern(f[0]);
+            item.description = intern(f[1]);
+            item.value       = toInt(line, f[2]);
+            if (f[3] != "hp" && f[3] != "sp" && f[3] != "revive") error(line, "expected hp, sp or revive, got", f[3]);
+            item.isSP     = f[3] == "sp";
+            item.isRevive = f[3] == "revive";
+            if (f[4] != "battle" && f[4] != "field") error(line, "expected battle or field, got", f[4]);
+            item.isBattle = f[4] == "battle";
+            mItems.push_back(item);
+        }
+        else if (kind == "equipment")
+        {
+            if (!expect(line, 2, 7)) return;
+            EquipmentRecord equipment = {};
+            equipment.name = intern(f[0]);
+            int type = findName(EQUIPMENT_TYPE_NAMES, 3, f[1]);
+            if (type < 0) error(line, "expected melee, gun or armor, got", f[1]);
+            equipment.type         = (uint8_t)(type < 0 ? 0 : type);
+            equipment.attackPower  = toInt(line, f[2]);
+            equipment.defensePower = toInt(line, f[3]);
+            equipment.magazineSize = toInt(line, f[4]);
+            equipment.element      = toElement(line, f[5]);
+            equipment.description  = intern(f[6]);
+            mEquipment.push_back(equipment);
+        }
+        else if (kind == "persona")
+        {
+            if (!expect(line, 2, 5)) return;
+            PersonaRecord persona = {};
+            persona.name        = intern(f[0]);
+            persona.baseAttack  = toInt(line, f[1]);
+            persona.baseDefense = toInt(line, f[2]);
+            persona.skills      = toList(line, f[3], &mSkillKeys);
+            persona.weaknesses  = toList(line, f[4], nullptr, true);
+            mPersonas.push_back(persona);
+        }
+        else if (kind == "member")
+        {
+            if (!expect(line, 2, 12)) return;
+            MemberRecord member = {};
+            member.id          = toInt(line, f[0]);
+            member.name        = intern(f[1]);
+            member.texturePath = intern(f[2]);
+            member.maxHp       = toInt(line, f[3]);
+            member.maxSp       = toInt(line, f[4]);
+            member.baseAttack  = toInt(line, f[5]);
+            member.baseDefense = toInt(line, f[6]);
+            member.meleeWeapon = toEquipment(line, f[7]);
+            member.gunWeapon   = toEquipment(line, f[8]);
+            member.armor       = toEquipment(line, f[9]);
+            member.skills      = toList(line, f[10], &mSkillKeys);
+            member.weaknesses  = toList(line, f[11], nullptr, true);
+            mMembers.push_back(member);
+        }
+        else if (kind == "enemy")
+        {
+            if (!expect(line, 2, 5)) return;
+            EnemyRecord enemy = {};
+            enemy.id          = toInt(line, line.head[1]);
+            enemy.name        = intern(f[0]);
+            enemy.maxHp       = toInt(line, f[1]);
+            enemy.baseAttack  = toInt(line, f[2]);
+            enemy.baseDefense = toInt(line, f[3]);
+            enemy.weaknesses  = toList(line, f[4], nullptr, true);
+            mEnemies.push_back(enemy);
+        }
+        else if (kind == "pool")
+        {
+            if (!expect(line, 3, 1)) return;
+            int poolKind = findName(POOL_KIND_NAMES, 5, line.head[1]);
+            if (poolKind < 0) { error(line, "unknown pool kind", line.head[1]); return; }
+
+            PoolRecord pool = {};
+            pool.kind  = (uint32_t) poolKind;
+            pool.level = line.head[2] == "*" ? POOL_ANY_LEVEL : toInt(line, line.head[2]);
+            for (const PoolRecord &other : mPools)
+                if (other.kind == pool.kind && other.level == pool.level) error(line, "duplicate pool", line.head[1] + " " + line.head[2]);
+
+            switch (poolKind)
+            {
+                case POOL_ENCOUNTER:       pool.entries = toList(line, f[0], nullptr, false, true); break;
+                case POOL_CHEST_EQUIPMENT:
+                case POOL_START_EQUIPMENT: pool.entries = toList(line, f[0], &mEquipmentKeys); break;
+                default:                   pool.entries = toList(line, f[0], &mItemKeys); break;
+            }
+            if (pool.entries.count == 0) error(line, "empty pool");
+            mPools.push_back(pool);
+        }
+    }
+
+    // What the game needs to start, mirroring ContentDB::validate()
+    void checkComplete()
+    {
+        auto missing = [](const char *what)
+        {
+            printf("%s: no %s\n", sInputPath, what);
+            sFailed = true;
+        };
+        auto hasPool = [&](int kind, int level, bool exact)
+        {
+            for (const PoolRecord &pool : mPools)
+                if ((int) pool.kind == kind && (pool.level == level || (!exact && pool.level == POOL_ANY_LEVEL))) return true;
+            return false;
+        };
+        if (mMembers.empty())  missing("member records (the starting party)");
+        if (mPersonas.empty()) missing("persona records");
+        if (!mEnemyIds.count(BOSS_ENEMY_ID)) missing("boss (enemy 99)");
+        for (int level = 0; level <= 1; level++)
+        {
+            std::string suffix = " " + std::to_string(level);
+            if (!hasPool(POOL_ENCOUNTER, level, true))        missing(("pool encounter" + suffix).c_str());
+            if (!hasPool(POOL_CHEST_ITEM, level, false))      missing(("pool chest_item" + suffix + " or *").c_str());
+            if (!hasPool(POOL_CHEST_EQUIPMENT, level, false)) missing(("pool chest_equipment" + suffix + " or *").c_str());
+        }
+        if (!hasPool(POOL_START_INVENTORY, POOL_ANY_LEVEL, true)) missing("pool start_inventory *");
+        if (!hasPool(POOL_START_EQUIPMENT, POOL_ANY_LEVEL, true)) missing("pool start_equipment *");
+    }
+
+    bool write(const char *path)
+    {
+        ContentHeader header = {};
+        header.magic   = CONTENT_MAGIC;
+        header.version = CONTENT_VERSION;
+
+        // Header, then each table in order, 4-byte aligned
+        std::vector<char> blob(sizeof(header));
+        auto append = [&](ContentTable table, const void *data, size_t bytes, uint32_t count)
+        {
+            blob.resize((blob.size() + 3) & ~(size_t) 3, 0);
+            header.tables[table].offset = (uint32_t) blob.size();
+            header.tables[table].count  = count;
+            const char *bytesIn = (const char *) data;
+            blob.insert(blob.end(), bytesIn, bytesIn + bytes);
+        };
+        append(TABLE_SKILLS,    mSkills.data(),    mSkills.size()    * sizeof(SkillRecord),     (uint32_t) mSkills.size());
+        append(TABLE_ITEMS,     mItems.data(),     mItems.size()     * sizeof(ItemRecord),      (uint32_t) mItems.size());
+        append(TABLE_EQUIPMENT, mEquipment.data(), mEquipment.size() * sizeof(EquipmentRecord), (uint32_t) mEquipment.size());
+        append(TABLE_PERSONAS,  mPersonas.data(),  mPersonas.size()  * sizeof(PersonaRecord),   (uint32_t) mPersonas.size());
+        append(TABLE_MEMBERS,   mMembers.data(),   mMembers.size()   * sizeof(MemberRecord),    (uint32_t) mMembers.size());
+        append(TABLE_ENEMIES,   mEnemies.data(),   mEnemies.size()   * sizeof(EnemyRecord),     (uint32_t) mEnemies.size());
+        append(TABLE_POOLS,     mPools.data(),     mPools.size()     * sizeof(PoolRecord),      (uint32_t) mPools.size());
+        append(TABLE_VALUES,    mValues.data(),    mValues.size()    * sizeof(uint32_t),        (uint32_t) mValues.size());
+        append(TABLE_STRINGS,   mStrings.data(),   mStrings.size(),                             (uint32_t) mStrings.size());
+
+        header.fileSize = (uint32_t) blob.size();
+        memcpy(blob.data(), &header, sizeof(header));
+
+        FILE *file = fopen(path, "wb");
+        if (!file)
+        {
+            printf("content_compiler: cannot write '%s'\n", path);
+            return false;
+        }
+        bool ok = fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+        ok = fclose(file) == 0 && ok;
+        if (!ok) printf("content_compiler: failed writing '%s'\n", path);
+        else printf("content_compiler: %s: %d skills, %d items, %d equipment, %d personas, %d members, %d enemies, "
+            "%d pools, %d bytes of strings, %d bytes\n", path, (int) mSkills.size(), (int) mItems.size(),
+            (int) mEquipment.size(), (int) mPersonas.size(), (int) mMembers.size(), (int) mEnemies.size(),
+            (int) mPools.size(), (int) mStrings.size(), (int) blob.size());
+        return ok;
+    }
+};
+
+static bool readLines(const char *path, std::vector<Line> &lines)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        printf("content_compiler: cannot open '%s'\n", path);
+        return false;
+    }
+
+    char buffer[1024];
+    int number = 0;
+    while (fgets(buffer, sizeof(buffer), file))
+    {
+        number++;
+        std::string text = trim(buffer);
+        if (text.empty() || text[0] == '#') continue;
+
+        Line line;
+        line.number = number;
+        size_t bar = text.find('|');
+        line.head = splitWords(text.substr(0, bar));
+        while (bar != std::string::npos)
+        {
+            size_t next = text.find('|', bar + 1);
+            line.fields.push_back(trim(text.substr(bar + 1, next == std::string::npos ? std::string::npos : next - bar - 1)));
+            bar = next;
+        }
+        lines.push_back(line);
+    }
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *input  = argc > 1 ? argv[1] : "assets/data/content.txt";
+    const char *output = argc > 2 ? argv[2] : "assets/data/content.bin";
+
+    sInputPath = input;
+
+    std::vector<Line> lines;
+    if (!readLines(input, lines)) return 1;
+
+    Compiler compiler;
+    for (const Line &line : lines) compiler.declare(line);
+    if (!sFailed)
+        for (const Line &line : lines) compiler.define(line);
+    if (!sFailed) compiler.checkComplete();
+    if (sFailed)
+    {
+        printf("content_compiler: errors in '%s', nothing written\n", input);
+        return 1;
+    }
+    return compiler.write(output) ? 0 : 1;
+}